@@ -1,14 +1,27 @@
 #include "AbstractGame.h"
+#include <algorithm>
 
-// 캯
-AbstractGame::AbstractGame(int s, std::shared_ptr<IMoveStrategy> moveStrat, std::shared_ptr<IWinStrategy> winStrat) 
-    : size(s), currentPlayer(PieceColor::BLACK), moveStrategy(moveStrat), winStrategy(winStrat) {
-    board.resize(size, std::vector<int>(size, 0));
+// 构造函数
+// 容器按整盘格子数预留，从内存区分配时不必反复扩容（扩容时旧缓冲在内存区里无法复用）
+AbstractGame::AbstractGame(int s, std::shared_ptr<IMoveStrategy> moveStrat, std::shared_ptr<IWinStrategy> winStrat,
+                           std::pmr::memory_resource* mem)
+    : size(s), board(s), currentPlayer(PieceColor::BLACK), observers(mem), history(mem), capturedStones(mem),
+      moveStrategy(moveStrat), winStrategy(winStrat), positionHistory(mem), changedCells(mem) {
+    history.reserve(size * size);
+    positionHistory.reserve(size * size);
+    changedCells.reserve(size * size);
+    positionHistory.insert(getPositionKey());
 }
 
-// ֪ͨ
+// 通知方法
 void AbstractGame::notifyBoardUpdate() {
-    for (auto& obs : observers) obs->onBoardUpdate(board, size);
+    for (auto& obs : observers) obs->onBoardUpdate(board);
+    changedCells.clear(); // 整盘通知已包含所有改动
+}
+
+void AbstractGame::notifyCellsChanged() {
+    for (auto& obs : observers) obs->onCellsChanged(board, changedCells.data(), (int)changedCells.size());
+    changedCells.clear();
 }
 
 void AbstractGame::notifyMessage(const std::string& msg) {
@@ -19,112 +32,326 @@ void AbstractGame::notifyGameOver(PieceColor winner) {
     for (auto& obs : observers) obs->onGameOver(winner);
 }
 
+void AbstractGame::endGame(PieceColor w) {
+    gameOver = true;
+    gameWinner = w;
+    notifyGameOver(w);
+}
+
 void AbstractGame::switchPlayer() {
     currentPlayer = (currentPlayer == PieceColor::BLACK) ? PieceColor::WHITE : PieceColor::BLACK;
+    hash ^= Zobrist::side();
+}
+
+void AbstractGame::setCell(int idx, uint8_t v) {
+    hash ^= Zobrist::piece(idx, board.at(idx)) ^ Zobrist::piece(idx, v);
+    board.setAt(idx, v);
+    changedCells.push_back({Board::rowOf(idx), Board::colOf(idx), v});
+}
+
+void AbstractGame::removeStone(int idx) {
+    setCell(idx, Board::EMPTY);
+    capturedStones.push_back(idx);
 }
 
-// ۲߹
+// 观察者管理
 void AbstractGame::addObserver(std::shared_ptr<IGameObserver> obs) {
     observers.push_back(obs);
 }
 
 void AbstractGame::refresh() {
     notifyBoardUpdate();
-    notifyMessage("ǰֵ: " + colorToString(currentPlayer));
+    notifyMessage("当前轮到: " + colorToString(currentPlayer));
 }
 
-// ģ巽
+namespace {
+
+// 分段计时：只有交互落子（Timed = true）且编译时启用统计才取时钟
+template <bool Timed>
+struct PhaseTimer {
+    explicit PhaseTimer(Metric) {}
+};
+#ifdef CHESS_METRICS
+template <>
+struct PhaseTimer<true> : ScopedTimer {
+    using ScopedTimer::ScopedTimer;
+};
+#endif
+
+} // namespace
+
+// 落子，不合法时抛出异常（读谱等不合法即为错误的场合）
 void AbstractGame::makeMove(int x, int y) {
-    if (x < 0 || x >= size || y < 0 || y >= size) throw GameException("곬Χ");
-    if (!moveStrategy->isValid(x, y, board, size)) throw GameException("˴");
-
-    passCount = 0; 
-    saveStateToHistory();
-    board[x][y] = (currentPlayer == PieceColor::BLACK) ? 1 : 2;
-    postMoveProcess(x, y);
-
-    // ӣforceEnd = false
-    // Χ壬 GoWinStrategy ᷵ NONE
-    // 壬GomokuWinStrategy ԲǷ
-    PieceColor winner = winStrategy->checkWin(board, size, false); 
-    
-    notifyBoardUpdate();
+    MoveStatus status = tryMove(x, y);
+    if (status != MoveStatus::OK) throw GameException(moveStatusText(status));
+}
+
+// 落子核心：检查、放子、提子、记入局面历史、判定胜负；胜负已分时不换手
+template <bool Timed>
+AbstractGame::UndoInfo AbstractGame::applyMove(int x, int y) {
+    UndoInfo u = {MoveStatus::OK, -1, currentPlayer, passCount, (int)capturedStones.size(), (int)changedCells.size(),
+                  gameOver, gameWinner};
+    if (gameOver) {
+        u.status = MoveStatus::GAME_OVER;
+        return u;
+    }
+    if (x < 0 || x >= size || y < 0 || y >= size) {
+        u.status = MoveStatus::OUT_OF_RANGE;
+        return u;
+    }
+    {
+        PhaseTimer<Timed> timer(Metric::MOVE_VALIDATE);
+        u.status = moveStrategy->isValid(x, y, board) ? preMoveCheck(x, y) : MoveStatus::OCCUPIED;
+    }
+    if (u.status != MoveStatus::OK) return u;
+
+    u.idx = Board::index(x, y);
+    passCount = 0;
+    setCell(u.idx, Board::fromColor(currentPlayer));
+    {
+        PhaseTimer<Timed> timer(Metric::MOVE_POST);
+        postMoveProcess(x, y);
+    }
+    positionHistory.insert(getPositionKey());
 
+    // 常规落子，只需检查经过新落子的线
+    // 对于围棋，这里 GoWinStrategy 会返回 NONE
+    // 对于五子棋，GomokuWinStrategy 从 (x, y) 向四个方向计数检查是否连五
+    PieceColor winner;
+    {
+        PhaseTimer<Timed> timer(Metric::MOVE_CHECKWIN);
+        winner = winStrategy->checkWinAt(board, x, y);
+    }
     if (winner != PieceColor::NONE) {
-        std::string w = colorToString(winner);
-        notifyMessage(">>> ʤʤ: " + w + " <<<");
-        notifyGameOver(winner);
+        gameOver = true;
+        gameWinner = winner;
     } else {
         switchPlayer();
-        notifyMessage("ֵ " + colorToString(currentPlayer) + " ");
     }
+    return u;
 }
 
-// ģ巽ͣһ (Χ)
-void AbstractGame::passTurn() {
-    if (getType() == GameType::GOMOKU) throw GameException("岻ͣһ");
-    
-    saveStateToHistory(); 
-    passCount++; 
-    
+AbstractGame::UndoInfo AbstractGame::play(int x, int y) {
+    return applyMove<false>(x, y);
+}
+
+AbstractGame::UndoInfo AbstractGame::playPass() {
+    UndoInfo u = {MoveStatus::OK, -1, currentPlayer, passCount, (int)capturedStones.size(), (int)changedCells.size(),
+                  gameOver, gameWinner};
+    if (gameOver) {
+        u.status = MoveStatus::GAME_OVER;
+        return u;
+    }
+    if (getType() == GameType::GOMOKU) {
+        u.status = MoveStatus::PASS_NOT_ALLOWED;
+        return u;
+    }
+    passCount++;
     if (passCount >= 2) {
-        // ˫֣ͣforceEnd = true
-        PieceColor winner = winStrategy->checkWin(board, size, true);
-        
+        // 双方停手，forceEnd = true
+        gameOver = true;
+        gameWinner = winStrategy->checkWin(board, true);
+        passCount = 0;
+    } else {
+        switchPlayer();
+    }
+    return u;
+}
+
+void AbstractGame::unplay(const UndoInfo& u) {
+    if (u.status != MoveStatus::OK) return;
+    revertMove(u.idx, u.player, u.passCount, u.captureStart);
+    gameOver = u.wasOver;
+    gameWinner = u.prevWinner;
+    if ((int)changedCells.size() > u.changeStart) changedCells.resize(u.changeStart);
+}
+
+// 撤回一步：把被撤销的局面移出历史，放回被提的棋子，再拿掉落下的棋子
+void AbstractGame::revertMove(int idx, PieceColor player, int pass, int captureStart) {
+    if (idx >= 0) {
+        auto it = positionHistory.find(getPositionKey());
+        if (it != positionHistory.end()) positionHistory.erase(it);
+
+        uint8_t captured = Board::fromColor(player == PieceColor::BLACK ? PieceColor::WHITE : PieceColor::BLACK);
+        for (int i = (int)capturedStones.size() - 1; i >= captureStart; --i) {
+            setCell(capturedStones[i], captured);
+        }
+        setCell(idx, Board::EMPTY);
+        onMoveReverted(idx, capturedStones.data() + captureStart, (int)capturedStones.size() - captureStart);
+        capturedStones.resize(captureStart);
+    }
+
+    if (currentPlayer != player) switchPlayer();
+    passCount = pass;
+}
+
+// 模板方法：交互落子 = 落子核心 + 走子记录 + 通知，不合法的着法以返回值报告
+MoveStatus AbstractGame::tryMove(int x, int y) {
+    METRIC_SCOPE(getType() == GameType::GO ? Metric::MOVE_GO : Metric::MOVE_GOMOKU);
+    UndoInfo u = applyMove<true>(x, y);
+    if (u.status != MoveStatus::OK) {
+        METRIC_COUNT(Counter::MOVE_REJECTED);
+        return u.status;
+    }
+    saveStateToHistory(u);
+
+    METRIC_SCOPE(Metric::MOVE_NOTIFY);
+    int captured = (int)capturedStones.size() - u.captureStart;
+    if (captured > 0) notifyMessage("提吃 " + std::to_string(captured) + " 子");
+    notifyCellsChanged();
+
+    if (gameOver) {
+        std::string w = colorToString(gameWinner);
+        notifyMessage(">>> 决出胜负！获胜者: " + w + " <<<");
+        notifyGameOver(gameWinner);
+    } else {
+        notifyMessage("轮到 " + colorToString(currentPlayer) + " 落子");
+    }
+    return MoveStatus::OK;
+}
+
+// 停一手，不允许时抛出异常
+void AbstractGame::passTurn() {
+    MoveStatus status = tryPass();
+    if (status != MoveStatus::OK) throw GameException(moveStatusText(status));
+}
+
+// 模板方法：停一手 (围棋)，五子棋以返回值报告
+MoveStatus AbstractGame::tryPass() {
+    UndoInfo u = playPass();
+    if (u.status != MoveStatus::OK) return u.status;
+    saveStateToHistory(u);
+
+    if (gameOver) {
         std::string details = winStrategy->getResultDescription();
-        std::string winnerStr = colorToString(winner);
+        std::string winnerStr = colorToString(gameWinner);
 
-        // װϢ 1.ʾ 2. 3.ʤ
+        // 组装完整信息：包含 1.结算提示 2.分数详情 3.最终胜者
         std::stringstream ss;
-        ss << ">>> ˫֣ͣʼ <<<\n";
+        ss << ">>> 双方停手，开始结算 <<<\n";
         if (!details.empty()) {
             ss << details << "\n";
         }
-        ss << ">>> ս: " + winnerStr + " ʤ <<<";
+        ss << ">>> 最终结果: " + winnerStr + " 胜 <<<";
 
         notifyMessage(ss.str());
-        notifyGameOver(winner);
-
-        passCount = 0; 
-        return;
+        notifyGameOver(gameWinner);
+        return MoveStatus::OK;
     }
 
-    switchPlayer();
-    notifyMessage(colorToString(currentPlayer == PieceColor::BLACK ? PieceColor::WHITE : PieceColor::BLACK) + " ͣһ");
-    notifyMessage("ֵ " + colorToString(currentPlayer) + " ");
+    notifyMessage(colorToString(currentPlayer == PieceColor::BLACK ? PieceColor::WHITE : PieceColor::BLACK) + " 停一手");
+    notifyMessage("轮到 " + colorToString(currentPlayer) + " 落子");
+    return MoveStatus::OK;
 }
 
-// ͨùܣ
+// 通用功能：悔棋
 void AbstractGame::undo() {
-    if (history.empty()) throw GameException("ûпԻļ¼");
-    auto mem = history.top();
-    history.pop();
-    restoreMemento(mem);
-    notifyMessage("ѻ壬ֵ " + colorToString(currentPlayer));
-    notifyBoardUpdate();
+    if (history.empty()) throw GameException("没有可以悔棋的记录");
+    MoveRecord rec = history.back();
+    history.pop_back();
+
+    revertMove(rec.idx, rec.player, rec.passCount, rec.captureStart);
+    gameOver = false;
+    gameWinner = PieceColor::NONE;
+
+    notifyMessage("已悔棋，轮到 " + colorToString(currentPlayer));
+    notifyCellsChanged();
 }
 
-// ͨùܣ
+// 通用功能：认输
 void AbstractGame::resign() {
     PieceColor winner = (currentPlayer == PieceColor::BLACK) ? PieceColor::WHITE : PieceColor::BLACK;
     std::string w = colorToString(winner);
     
-    notifyMessage(">>> Է䣬ʤ: " + w + " <<<");
-    notifyGameOver(winner);
+    notifyMessage(">>> 对方认输，获胜者: " + w + " <<<");
+    endGame(winner);
 }
 
-// ¼
-void AbstractGame::saveStateToHistory() {
-    history.push(std::make_shared<GameMemento>(board, currentPlayer, size, getType(), passCount));
+// 历史记录：记下恢复所需的最少信息（即 play 返回的撤销数据）
+void AbstractGame::saveStateToHistory(const UndoInfo& u) {
+    METRIC_SCOPE(Metric::MOVE_HISTORY);
+    history.push_back({u.idx, u.player, u.passCount, u.captureStart});
 }
 
+// 收集空点作为候选着法（不检查具体棋类的落子规则），终局时为空
+void AbstractGame::collectEmptyCells(MoveList& out, MoveGenMode mode) const {
+    out.clear();
+    if (gameOver) return;
+
+    if (mode == MoveGenMode::ALL) {
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                int idx = Board::index(i, j);
+                if (board.at(idx) == Board::EMPTY) out.add(idx);
+            }
+        }
+        return;
+    }
+
+    // 先把每颗棋子周围 5x5 的范围标出来，再按行优先收集被标记的空点，保证输出顺序固定
+    uint8_t near[Board::CAPACITY] = {};
+    bool any = false;
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            if (board.at(Board::index(i, j)) == Board::EMPTY) continue;
+            any = true;
+            for (int x = std::max(0, i - 2); x <= std::min(size - 1, i + 2); ++x) {
+                for (int y = std::max(0, j - 2); y <= std::min(size - 1, j + 2); ++y) near[Board::index(x, y)] = 1;
+            }
+        }
+    }
+    if (!any) {
+        out.add(Board::index(size / 2, size / 2));
+        return;
+    }
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            int idx = Board::index(i, j);
+            if (near[idx] && board.at(idx) == Board::EMPTY) out.add(idx);
+        }
+    }
+}
+
+// 沿走子记录倒推出记录开始时的棋盘（开局或读档时的局面）
+Board AbstractGame::getInitialBoard() const {
+    Board b = board;
+    int captureEnd = (int)capturedStones.size();
+    for (int k = (int)history.size() - 1; k >= 0; --k) {
+        const MoveRecord& rec = history[k];
+        if (rec.idx < 0) continue;
+        uint8_t captured = Board::fromColor(rec.player == PieceColor::BLACK ? PieceColor::WHITE : PieceColor::BLACK);
+        for (int i = rec.captureStart; i < captureEnd; ++i) b.setAt(capturedStones[i], captured);
+        captureEnd = rec.captureStart;
+        b.setAt(rec.idx, Board::EMPTY);
+    }
+    return b;
+}
+
+// 备忘录管理（完整快照，用于存档）
+
 std::shared_ptr<GameMemento> AbstractGame::createMemento() {
-    return std::make_shared<GameMemento>(board, currentPlayer, size, getType(), passCount);
+    std::vector<int> moves;
+    moves.reserve(history.size());
+    for (const auto& rec : history) {
+        moves.push_back(rec.idx < 0 ? -1 : Board::rowOf(rec.idx) * size + Board::colOf(rec.idx));
+    }
+    return std::make_shared<GameMemento>(board, currentPlayer, size, getType(), passCount, std::move(moves));
 }
 
+// 读档：存档不含历史，以读入的局面作为新的起点
 void AbstractGame::restoreMemento(std::shared_ptr<GameMemento> mem) {
     this->board = mem->boardData;
     this->currentPlayer = mem->currentPlayer;
     this->size = mem->boardSize;
     this->passCount = mem->passCount;
+    this->gameOver = false;
+    this->gameWinner = PieceColor::NONE;
+    this->hash = Zobrist::hashBoard(board) ^ (currentPlayer == PieceColor::WHITE ? Zobrist::side() : 0);
+    onBoardRestored();
+
+    history.clear();
+    capturedStones.clear();
+    changedCells.clear();
+    positionHistory.clear();
+    positionHistory.insert(getPositionKey());
 }
@@ -3,48 +3,157 @@
 
 #include <vector>
 #include <memory>
-#include <stack>
 #include <sstream>
+#include <unordered_set>
+#include <cstdint>
 #include "GameTypes.h"
 #include "Observer.h"
 #include "Strategy.h"
 #include "GameMemento.h"
+#include "Zobrist.h"
+#include "GameArena.h"
+#include "Metrics.h"
 
-// Ϸ߼ࣨTemplate Method Pattern
+// 着法生成的范围
+enum class MoveGenMode {
+    ALL,         // 全部合法着法
+    NEAR_STONES  // 只取与已有棋子距离不超过 2（横、竖、斜各两格内）的点；空盘时只取天元
+};
+
+// 调用方提供的定长着法缓冲区，容量足够放下整盘，生成着法时不分配堆内存
+// 着法以 Board 下标存放（行列用 Board::rowOf / colOf 取回），不含停一手
+struct MoveList {
+    static constexpr int CAPACITY = Board::MAX_SIZE * Board::MAX_SIZE;
+
+    int moves[CAPACITY];
+    int count = 0;
+
+    void clear() { count = 0; }
+    void add(int idx) { moves[count++] = idx; }
+    int size() const { return count; }
+    int operator[](int i) const { return moves[i]; }
+    const int* begin() const { return moves; }
+    const int* end() const { return moves + count; }
+};
+
+// 游戏逻辑基类（Template Method Pattern）
 class AbstractGame {
+public:
+    // 悔棋用的走子记录：只记变化量，不保存整盘快照
+    struct MoveRecord {
+        int idx;              // 落子位置的 Board 下标，停一手为 -1
+        PieceColor player;    // 行棋前的当前玩家
+        int passCount;        // 行棋前的停手计数
+        int captureStart;     // 本步提子在 capturedStones 中的起始位置（到末尾或下一条记录为止）
+    };
+
+    // play / playPass 的撤销数据：按值返回，放在调用方的栈上，原样交给 unplay
+    // status 不为 OK 时表示着法被拒绝，局面未改动，unplay 对它什么也不做
+    struct UndoInfo {
+        MoveStatus status;
+        int idx;              // 落子位置的 Board 下标，停一手为 -1
+        PieceColor player;    // 行棋前的当前玩家
+        int passCount;        // 行棋前的停手计数
+        int captureStart;     // 本步提子在 capturedStones 中的起始位置
+        int changeStart;      // 行棋前 changedCells 的长度，unplay 后截回，未通知的试走不会残留
+        bool wasOver;         // 行棋前的胜负状态
+        PieceColor prevWinner;
+    };
+
 protected:
     int size;
-    std::vector<std::vector<int>> board; // 洢״̬0, 1, 2
+    Board board; // 存储棋盘状态：0空, 1黑, 2白
     PieceColor currentPlayer;
-    std::vector<std::shared_ptr<IGameObserver>> observers;
-    std::stack<std::shared_ptr<GameMemento>> history; // ʷ¼ڻ
+    // 以下容器都从构造时给定的内存资源分配（默认为全局堆，批量对局时为每线程的 GameArena）
+    std::pmr::vector<std::shared_ptr<IGameObserver>> observers;
+    std::pmr::vector<MoveRecord> history;   // 历史记录用于悔棋
+    std::pmr::vector<int> capturedStones;   // 所有步的提子位置，按步顺序连续存放
 	
 	std::shared_ptr<IMoveStrategy> moveStrategy;
     std::shared_ptr<IWinStrategy> winStrategy;
     int passCount = 0;
+    bool gameOver = false;                    // 是否已决出胜负（悔棋后恢复为未结束）
+    PieceColor gameWinner = PieceColor::NONE; // 胜者，未结束时为 NONE
+
+    uint64_t hash = 0; // 局面的 Zobrist 哈希（棋子 + 行棋方），随落子/提子/换手增量更新
+    std::pmr::unordered_multiset<uint64_t> positionHistory; // 出现过的棋子局面（不含行棋方），用于同形判断
+    std::pmr::vector<CellChange> changedCells; // 自上次通知以来改动过的格子，由 setCell 记录
     
     void notifyBoardUpdate();
+    void notifyCellsChanged(); // 发出增量通知并清空 changedCells
     void notifyMessage(const std::string& msg);
     void notifyGameOver(PieceColor winner);
+    void endGame(PieceColor w); // 记录胜负并通知观察者
     void switchPlayer();
 
+    // 修改一个格子并同步更新哈希、记入 changedCells，所有落子/提子都应经过这里
+    void setCell(int idx, uint8_t v);
+
+    // 提掉一颗棋子并记入当前步的走子记录，供悔棋时放回
+    void removeStone(int idx);
+
+    // 钩子方法：棋盘被整体替换后（悔棋/读档），派生类据此重建自己的缓存状态
+    virtual void onBoardRestored() {}
+    // 钩子方法：撤回落在 idx 的一步之后调用（棋盘已复原，captured 为放回的棋子），默认按整体替换处理
+    virtual void onMoveReverted(int idx, const int* captured, int count) { onBoardRestored(); }
+
+    // play 与 tryMove 共用的落子核心；Timed 为 true 时按阶段计时（只用于交互落子，搜索热路径不取时钟）
+    template <bool Timed>
+    UndoInfo applyMove(int x, int y);
+    // unplay 与 undo 共用：撤回一步并恢复行棋方与停手计数
+    void revertMove(int idx, PieceColor player, int pass, int captureStart);
+
+    // 按 mode 把空点依次（行优先）写入 out，供各游戏的 generateMoves 再按自己的规则筛选
+    void collectEmptyCells(MoveList& out, MoveGenMode mode) const;
+
 public:
-    AbstractGame(int s, std::shared_ptr<IMoveStrategy> moveStrat, std::shared_ptr<IWinStrategy> winStrat);
+    AbstractGame(int s, std::shared_ptr<IMoveStrategy> moveStrat, std::shared_ptr<IWinStrategy> winStrat,
+                 std::pmr::memory_resource* mem = std::pmr::get_default_resource());
     virtual ~AbstractGame() = default;
     virtual GameType getType() const = 0;
-    virtual void postMoveProcess(int x, int y) = 0; // ӷϷĶ⴦
+    virtual MoveStatus preMoveCheck(int x, int y) { return MoveStatus::OK; } // 钩子方法：具体游戏的额外规则检查
+    virtual void postMoveProcess(int x, int y) = 0; // 钩子方法：具体游戏的额外处理
+
+    // 当前行棋方的全部合法着法写入 out（先清空），返回着法数；已终局时为 0
+    // 结果与逐个 tryMove 判定一致，但不改动局面、不抛异常也不分配内存
+    virtual int generateMoves(MoveList& out, MoveGenMode mode = MoveGenMode::ALL) const = 0;
 
     void addObserver(std::shared_ptr<IGameObserver> obs);
 	void refresh();
+
+    // 状态查询
+    int getSize() const { return size; }
+    const Board& getBoard() const { return board; }
+    PieceColor getCurrentPlayer() const { return currentPlayer; }
+    bool isOver() const { return gameOver; }
+    PieceColor getWinner() const { return gameWinner; }
+    const std::pmr::vector<MoveRecord>& getHistory() const { return history; }
+    Board getInitialBoard() const; // 沿走子记录倒推出记录开始时的棋盘
+
+    // 局面键
+    uint64_t getHash() const { return hash; }
+    uint64_t getPositionKey() const { return hash ^ (currentPlayer == PieceColor::WHITE ? Zobrist::side() : 0); }
+    bool hasSeenPosition(uint64_t positionKey) const { return positionHistory.count(positionKey) > 0; }
+    const std::pmr::unordered_multiset<uint64_t>& getPositionHistory() const { return positionHistory; }
     
-    // ģ巽
-    void makeMove(int x, int y);
-    void passTurn();
+    // 模板方法
+    void makeMove(int x, int y);     // 不合法时抛出 GameException
+    MoveStatus tryMove(int x, int y); // 不合法时返回原因、不改动局面，不抛异常
+    void passTurn();                  // 不允许停手时抛出 GameException
+    MoveStatus tryPass();             // 五子棋返回 PASS_NOT_ALLOWED、不改动局面，不抛异常
     void undo();
     void resign();
+
+    // 轻量走子，供搜索与重放校验使用：检查合法性、提子、更新胜负状态，
+    // 不写走子记录、不拼接字符串、不抛异常、不通知观察者；撤销数据按值返回
+    // 成对使用：unplay 须按 play 的相反顺序调用，其间不应穿插 makeMove / undo 等交互调用
+    UndoInfo play(int x, int y);
+    UndoInfo playPass(); // 五子棋返回 PASS_NOT_ALLOWED；围棋双方连续停手时数子终局
+    // 已决出胜负后 play / playPass / tryMove / tryPass 一律返回 GAME_OVER（悔棋或撤销后恢复）
+    void unplay(const UndoInfo& u);
     
-    // ¼
-    void saveStateToHistory();
+    // 备忘录管理
+    void saveStateToHistory(const UndoInfo& u);
     std::shared_ptr<GameMemento> createMemento();
     void restoreMemento(std::shared_ptr<GameMemento> mem);
 };
@@ -0,0 +1,160 @@
+#include "AsyncObserver.h"
+
+AsyncObserver::AsyncObserver(size_t capacity, BackpressurePolicy p, int threads)
+    : ring(capacity), policy(p), targets(std::make_shared<const TargetList>()) {
+    if (threads < 1) threads = 1;
+    for (int i = 0; i < threads; ++i) workers.emplace_back([this]() { workerLoop(); });
+}
+
+AsyncObserver::~AsyncObserver() {
+    running.store(false);
+    {
+        std::lock_guard<std::mutex> lk(sleepMutex);
+        wake.notify_all();
+    }
+    for (auto& t : workers) t.join();
+}
+
+void AsyncObserver::addObserver(std::shared_ptr<IGameObserver> obs) {
+    std::lock_guard<std::mutex> lk(targetsMutex);
+    auto next = std::make_shared<TargetList>(*std::atomic_load(&targets));
+    next->push_back(obs);
+    std::atomic_store(&targets, std::shared_ptr<const TargetList>(std::move(next)));
+}
+
+// 取一个可写的槽；队列满时按策略等待或放弃
+AsyncObserver::Event* AsyncObserver::claim(bool mayDrop) {
+    while (true) {
+        Event* e = ring.tryClaim();
+        if (e) return e;
+        if (mayDrop && policy == BackpressurePolicy::DROP) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void AsyncObserver::publish() {
+    ring.publish();
+    ++published;
+    // 与分发线程登记 sleepers 配对的全屏障，保证不会漏掉唤醒
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lk(sleepMutex);
+        wake.notify_one();
+    }
+}
+
+void AsyncObserver::flush() {
+    if (needResync) resync(false);
+    while (delivered.load(std::memory_order_acquire) < published) std::this_thread::yield();
+}
+
+void AsyncObserver::dropBoard(const Board& board) {
+    pendingBoard = board;
+    needResync = true;
+}
+
+// 把丢掉的最新棋盘作为整盘通知补发
+void AsyncObserver::resync(bool mayDrop) {
+    Event* e = claim(mayDrop);
+    if (!e) return;
+    e->kind = Event::BOARD;
+    e->board = pendingBoard;
+    needResync = false;
+    publish();
+}
+
+void AsyncObserver::onBoardUpdate(const Board& board) {
+    Event* e = claim(true);
+    if (!e) {
+        dropBoard(board);
+        return;
+    }
+    e->kind = Event::BOARD;
+    e->board = board;
+    needResync = false;
+    publish();
+}
+
+void AsyncObserver::onCellsChanged(const Board& board, const CellChange* changes, int count) {
+    Event* e = claim(true);
+    if (!e) {
+        dropBoard(board);
+        return;
+    }
+    e->board = board;
+    if (needResync) {
+        // 之前丢过事件，增量接不上，这次改发整盘
+        e->kind = Event::BOARD;
+        needResync = false;
+    } else {
+        e->kind = Event::CELLS;
+        e->changes.assign(changes, changes + count);
+    }
+    publish();
+}
+
+void AsyncObserver::onMessage(const std::string& msg) {
+    if (needResync) resync(true);
+    Event* e = claim(true);
+    if (!e) return;
+    e->kind = Event::MESSAGE;
+    e->text = msg;
+    publish();
+}
+
+void AsyncObserver::onGameOver(PieceColor winner) {
+    if (needResync) resync(false);
+    Event* e = claim(false);
+    e->kind = Event::GAME_OVER;
+    e->winner = winner;
+    publish();
+}
+
+void AsyncObserver::deliver(const Event& e) {
+    std::shared_ptr<const TargetList> list = std::atomic_load(&targets);
+    for (auto& obs : *list) {
+        try {
+            switch (e.kind) {
+            case Event::BOARD: obs->onBoardUpdate(e.board); break;
+            case Event::CELLS: obs->onCellsChanged(e.board, e.changes.data(), (int)e.changes.size()); break;
+            case Event::MESSAGE: obs->onMessage(e.text); break;
+            case Event::GAME_OVER: obs->onGameOver(e.winner); break;
+            }
+        } catch (const std::exception&) {
+            // 分发线程上没有调用方可以接住异常，单个观察者出错不影响其他观察者
+        }
+    }
+}
+
+void AsyncObserver::workerLoop() {
+    int idle = 0;
+    while (true) {
+        uint64_t pos;
+        Event* e = ring.tryAcquire(pos);
+        if (e) {
+            deliver(*e);
+            ring.release(pos);
+            delivered.fetch_add(1, std::memory_order_release);
+            idle = 0;
+            continue;
+        }
+        if (!running.load()) break; // 已停止且队列已空
+        if (++idle < 64) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // 连续空转后睡眠，等生产者唤醒
+        sleepers.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lk(sleepMutex);
+            wake.wait(lk, [this]() { return !ring.empty() || !running.load(); });
+        }
+        sleepers.fetch_sub(1);
+        idle = 0;
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef ASYNCOBSERVER_H
+#define ASYNCOBSERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Observer.h"
+#include "SpmcRing.h"
+
+// 队列满时的处理策略
+enum class BackpressurePolicy {
+    BLOCK, // 等待分发线程腾出位置（不丢事件）
+    DROP   // 直接丢弃；丢掉的棋盘事件会在下一次改成整盘通知补齐，对局结束事件从不丢弃
+};
+
+// 异步观察者（装饰器）：挂到游戏上时只把事件写入无锁环形队列就返回，
+// 由后台分发线程把事件转发给登记的观察者，慢观察者不再拖慢落子
+// 多个分发线程时事件可能被并发、乱序地转发，观察者需自行保证线程安全
+class AsyncObserver : public IGameObserver {
+public:
+    struct Event {
+        enum Kind { BOARD, CELLS, MESSAGE, GAME_OVER } kind = BOARD;
+        Board board;                     // BOARD/CELLS：事件发生时的棋盘
+        std::vector<CellChange> changes; // CELLS：变化的格子
+        std::string text;                // MESSAGE
+        PieceColor winner = PieceColor::NONE;
+    };
+
+private:
+    SpmcRing<Event> ring;
+    BackpressurePolicy policy;
+
+    // 登记的观察者列表：写时复制，分发线程原子地取快照，不必加锁
+    using TargetList = std::vector<std::shared_ptr<IGameObserver>>;
+    std::shared_ptr<const TargetList> targets;
+    std::mutex targetsMutex; // 只串行化 addObserver
+
+    std::vector<std::thread> workers;
+    std::atomic<bool> running{true};
+
+    // 分发线程空闲时睡眠，生产者发现有线程在睡才去加锁唤醒
+    std::atomic<int> sleepers{0};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    uint64_t published = 0; // 只由生产者（游戏线程）访问
+    std::atomic<uint64_t> delivered{0};
+    std::atomic<uint64_t> dropped{0};
+    bool needResync = false; // 丢过棋盘事件，观察者手里的棋盘已不可信
+    Board pendingBoard;      // 丢掉的最新棋盘，等队列有空位时补发整盘
+
+    Event* claim(bool mayDrop);
+    void dropBoard(const Board& board);
+    void resync(bool mayDrop);
+    void publish();
+    void workerLoop();
+    void deliver(const Event& e);
+
+public:
+    explicit AsyncObserver(size_t capacity = 1024, BackpressurePolicy p = BackpressurePolicy::BLOCK, int threads = 1);
+    ~AsyncObserver() override; // 转发完队列中剩余的事件后退出
+
+    void addObserver(std::shared_ptr<IGameObserver> obs);
+
+    // 补发丢掉的棋盘并等待已入队的事件全部转发完（只能在生产者线程调用）
+    void flush();
+    uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    // IGameObserver 实现：只入队，不等待
+    void onBoardUpdate(const Board& board) override;
+    void onCellsChanged(const Board& board, const CellChange* changes, int count) override;
+    void onMessage(const std::string& msg) override;
+    void onGameOver(PieceColor winner) override;
+};
+
+#endif // ASYNCOBSERVER_H
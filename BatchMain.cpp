@@ -0,0 +1,92 @@
+/*
+ * 无界面批量对局入口：用于压力测试与生成棋谱语料
+ * 用法: batch_runner [--game gomoku|go] [--size N] [--games N] [--threads N]
+ *                    [--engine] [--engine-ms N] [--seed N] [--sgf file] [--summary file]
+ *                    [--dead-stones N] [--kernel]
+ * --kernel 改用精简对局内核；围棋内核只禁单劫、不禁全局同形，与默认的 GoGame 规则在长循环劫上不同，
+ *          统计行末的 ko= 标明本次所用的劫规则
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include "BatchRunner.h"
+
+int main(int argc, char* argv[]) {
+    BatchConfig config;
+    std::string summaryPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "缺少参数值: " << arg << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--game") {
+            std::string t = value();
+            if (t == "go") config.type = GameType::GO;
+            else if (t == "gomoku") config.type = GameType::GOMOKU;
+            else {
+                std::cerr << "未知的游戏类型: " << t << "\n";
+                return 2;
+            }
+        } else if (arg == "--size") {
+            config.boardSize = std::atoi(value().c_str());
+        } else if (arg == "--games") {
+            config.games = std::atol(value().c_str());
+        } else if (arg == "--threads") {
+            config.threads = std::atoi(value().c_str());
+        } else if (arg == "--engine") {
+            config.useEngine = true;
+        } else if (arg == "--engine-ms") {
+            config.engineMs = std::atoi(value().c_str());
+            if (config.engineMs <= 0) {
+                std::cerr << "--engine-ms 必须为正数\n";
+                return 2;
+            }
+        } else if (arg == "--seed") {
+            config.seed = std::strtoull(value().c_str(), nullptr, 10);
+        } else if (arg == "--sgf") {
+            config.sgfPath = value();
+        } else if (arg == "--dead-stones") {
+            config.deadStonePlayouts = std::atoi(value().c_str());
+        } else if (arg == "--kernel") {
+            config.useKernel = true;
+        } else if (arg == "--summary") {
+            summaryPath = value();
+        } else {
+            std::cerr << "未知参数: " << arg << "\n";
+            return 2;
+        }
+    }
+    if (config.boardSize < 8 || config.boardSize > 19) {
+        std::cerr << "尺寸必须在 8 到 19 之间\n";
+        return 2;
+    }
+
+    if (config.useKernel && (config.useEngine || !config.sgfPath.empty() || config.deadStonePlayouts > 0)) {
+        std::cerr << "--kernel 不能与 --engine、--sgf、--dead-stones 同时使用\n";
+        return 2;
+    }
+    if (config.useKernel && config.type == GameType::GO) {
+        std::cerr << "注意: 围棋对局内核只禁单劫，不禁全局同形，结果与不加 --kernel 时不可直接比较\n";
+    }
+
+    try {
+        BatchSummary summary = BatchRunner(config).run();
+        std::cout << summary.toString() << "\n";
+        if (!summaryPath.empty()) {
+            std::ofstream ofs(summaryPath, std::ios::app);
+            if (!ofs) throw GameException("文件创建失败");
+            ofs << summary.toString() << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "错误: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
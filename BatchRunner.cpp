@@ -0,0 +1,183 @@
+#include "BatchRunner.h"
+#include "GameFactory.h"
+#include "GomokuEngine.h"
+#include "GoMcts.h"
+#include "Sgf.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+std::string BatchSummary::toString() const {
+    std::stringstream ss;
+    ss << "games=" << games << " black_wins=" << blackWins << " white_wins=" << whiteWins
+       << " draws=" << draws << " moves=" << moves << " threads=" << threads
+       << " elapsed_ms=" << (long)elapsedMs << " games_per_sec=" << gamesPerSec()
+       << " moves_per_sec=" << movesPerSec();
+    if (koRule) ss << " ko=" << koRule;
+    return ss.str();
+}
+
+namespace {
+
+// 随机策略：在合法着法中均匀随机挑选；围棋不填己方眼
+bool playRandomMove(AbstractGame& game, std::mt19937_64& rng, MoveList& moves) {
+    const Board& board = game.getBoard();
+    uint8_t me = Board::fromColor(game.getCurrentPlayer());
+    game.generateMoves(moves);
+
+    while (moves.count > 0) {
+        int k = (int)(rng() % (uint64_t)moves.count);
+        int idx = moves.moves[k];
+        if (game.getType() == GameType::GO) {
+            bool eye = true;
+            for (int d : GoChains::DIRS) {
+                uint8_t v = board.at(idx + d);
+                if (v != me && v != Board::BORDER) eye = false;
+            }
+            if (eye) {
+                moves.moves[k] = moves.moves[--moves.count]; // 剔除后在剩余着法中重新挑选
+                continue;
+            }
+        }
+        game.makeMove(Board::rowOf(idx), Board::colOf(idx));
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+BatchSummary BatchRunner::run() {
+    int threads = config.threads;
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+
+    std::atomic<long> nextGame{0};
+    std::atomic<long> blackWins{0}, whiteWins{0}, draws{0}, moves{0};
+    std::mutex sgfMutex;
+    std::ofstream sgf;
+    if (!config.sgfPath.empty()) {
+        sgf.open(config.sgfPath, std::ios::binary | std::ios::app);
+        if (!sgf) throw GameException("文件创建失败");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto work = [&](int t) {
+        std::mt19937_64 rng(config.seed * 1000003 + t);
+        MoveList legalMoves;
+        std::unique_ptr<GomokuEngine> gomokuEngine;
+        std::unique_ptr<GoMcts> goEngine;
+        if (config.useEngine && config.type == GameType::GOMOKU) gomokuEngine.reset(new GomokuEngine(16));
+        if (config.useEngine && config.type == GameType::GO) goEngine.reset(new GoMcts((size_t)1 << 16));
+
+        std::shared_ptr<IGameFactory> factory;
+        if (config.type == GameType::GO) factory = std::make_shared<GoFactory>();
+        else factory = std::make_shared<GomokuFactory>();
+
+        // 内核模式：整局随机对局在编译期特化的内核里完成，每局只有一次虚调用
+        if (config.useKernel) {
+            std::unique_ptr<IGameKernel> kernel = factory->createKernel(config.boardSize);
+            uint64_t state = rng() | 1;
+            int maxMoves = config.boardSize * config.boardSize * config.maxMovesFactor;
+            for (long g = nextGame++; g < config.games; g = nextGame++) {
+                kernel->reset();
+                moves += kernel->playRandomGame(state, maxMoves);
+                if (kernel->getWinner() == PieceColor::BLACK) blackWins++;
+                else if (kernel->getWinner() == PieceColor::WHITE) whiteWins++;
+                else draws++;
+            }
+            return;
+        }
+
+        // 每个线程一个内存区：对局对象、策略、走子记录都从这里分配，每局结束后整体收回
+        GameArena arena;
+        for (long g = nextGame++; g < config.games; g = nextGame++) {
+            std::shared_ptr<AbstractGame> game = factory->createGame(config.boardSize, &arena);
+            if (config.type == GameType::GO && config.deadStonePlayouts > 0) {
+                // 对局本身已按线程并行，死子估计在本线程内完成
+                OwnershipConfig dead;
+                dead.playouts = config.deadStonePlayouts;
+                dead.threads = 1;
+                dead.seed = config.seed * 1000003 + g;
+                static_cast<GoGame&>(*game).setDeadStoneEstimation(dead);
+            }
+            int maxMoves = config.boardSize * config.boardSize * config.maxMovesFactor;
+            int played = 0;
+
+            while (!game->isOver()) {
+                if (played >= maxMoves) {
+                    // 步数超限：围棋双方停手结算，五子棋判和
+                    if (game->getType() == GameType::GO) {
+                        game->passTurn();
+                        if (!game->isOver()) game->passTurn();
+                    }
+                    break;
+                }
+
+                bool moved = false;
+                if (gomokuEngine) {
+                    SearchLimits limits;
+                    limits.timeMs = config.engineMs;
+                    SearchResult res = gomokuEngine->search(*game, limits);
+                    if (res.x >= 0) {
+                        game->makeMove(res.x, res.y);
+                        moved = true;
+                    }
+                } else if (goEngine) {
+                    MctsLimits limits;
+                    limits.timeMs = config.engineMs;
+                    limits.threads = 1;
+                    MctsResult res = goEngine->search(static_cast<const GoGame&>(*game), limits);
+                    if (!res.pass) {
+                        game->makeMove(res.x, res.y);
+                        moved = true;
+                    }
+                } else {
+                    moved = playRandomMove(*game, rng, legalMoves);
+                }
+
+                if (!moved) {
+                    if (game->getType() == GameType::GOMOKU) break; // 棋盘下满，和棋
+                    game->passTurn();
+                }
+                played++;
+            }
+
+            moves += played;
+            if (game->getWinner() == PieceColor::BLACK) blackWins++;
+            else if (game->getWinner() == PieceColor::WHITE) whiteWins++;
+            else draws++;
+
+            if (sgf.is_open()) {
+                std::string record = SgfWriter::write(*game);
+                std::lock_guard<std::mutex> lock(sgfMutex);
+                sgf << record;
+            }
+
+            game.reset();
+            arena.reset();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; ++t) workers.emplace_back(work, t);
+    work(0);
+    for (auto& w : workers) w.join();
+
+    BatchSummary summary;
+    summary.games = config.games;
+    summary.blackWins = blackWins;
+    summary.whiteWins = whiteWins;
+    summary.draws = draws;
+    summary.moves = moves;
+    summary.threads = threads;
+    if (config.type == GameType::GO) summary.koRule = config.useKernel ? "simple-ko" : "superko";
+    summary.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
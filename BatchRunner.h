@@ -0,0 +1,51 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <string>
+#include <cstdint>
+#include "GameTypes.h"
+
+// 批量对局配置
+struct BatchConfig {
+    GameType type = GameType::GOMOKU;
+    int boardSize = 15;
+    long games = 100;
+    int threads = 0;          // 0 表示使用全部硬件线程
+    bool useEngine = false;   // false: 随机落子; true: 使用搜索引擎
+    int engineMs = 10;        // 引擎每步思考时间
+    int maxMovesFactor = 3;   // 每局最多 size*size*因子 步，超出按停手结算
+    uint64_t seed = 1;
+    int deadStonePlayouts = 0; // 围棋终局结算时估计死子的随机对局数，0 表示不估计
+    // 随机对局改用精简对局内核，不能与引擎、棋谱输出、死子估计同用
+    // 围棋内核只禁单劫，不禁全局同形：有长循环劫时对局走向与 GoGame 不同，统计不能与不用内核的结果直接比较
+    bool useKernel = false;
+    std::string sgfPath;      // 非空时把每局棋谱追加到该文件
+};
+
+// 批量对局统计
+struct BatchSummary {
+    long games = 0;
+    long blackWins = 0;
+    long whiteWins = 0;
+    long draws = 0;
+    long moves = 0;
+    int threads = 0;
+    double elapsedMs = 0;
+    const char* koRule = nullptr; // 围棋的劫规则（superko / simple-ko），五子棋为空
+
+    double gamesPerSec() const { return elapsedMs > 0 ? games * 1000.0 / elapsedMs : 0; }
+    double movesPerSec() const { return elapsedMs > 0 ? moves * 1000.0 / elapsedMs : 0; }
+    std::string toString() const;
+};
+
+// 无界面批量对局：通过游戏工厂创建对局，不挂任何观察者，在多个线程上并发执行
+class BatchRunner {
+private:
+    BatchConfig config;
+
+public:
+    explicit BatchRunner(const BatchConfig& cfg) : config(cfg) {}
+    BatchSummary run();
+};
+
+#endif // BATCHRUNNER_H
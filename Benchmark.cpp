@@ -0,0 +1,601 @@
+/*
+ * 基准测试：落子、提子、胜负判定、结算、存读档与悔棋的耗时
+ * 基于 Google Benchmark，默认输出 JSON，便于与历史结果对比发现性能回退
+ * 用法: chess_bench [--benchmark_filter=正则] [--benchmark_out=文件] [--benchmark_format=console|json|csv]
+ * 参数约定：/尺寸/密度 中的密度为棋盘已落子格数的百分比
+ */
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "AsyncObserver.h"
+#include "GameFactory.h"
+#include "CommandParser.h"
+#include "OpeningBook.h"
+#include "GoGame.h"
+#include "GomokuGame.h"
+#include "GoStrategy.h"
+#include "GomokuStrategy.h"
+
+namespace {
+
+const int SIZES[] = {8, 9, 13, 15, 19};
+const int DENSITIES[] = {10, 30, 60};
+const int BATCH = 16; // 每轮计时的落子/悔棋手数
+
+using Clock = std::chrono::steady_clock;
+
+void sizeDensityArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"size", "density"});
+    for (int s : SIZES)
+        for (int d : DENSITIES) b->Args({s, d});
+}
+
+int countStones(const Board& board) {
+    int n = 0, size = board.getSize();
+    for (int i = 0; i < size; ++i)
+        for (int j = 0; j < size; ++j)
+            if (board.get(i, j) != Board::EMPTY) ++n;
+    return n;
+}
+
+// 围棋：随机合法对弈，直到棋子数达到目标密度（提子会让密度回落，尝试次数有上限）
+void fillGo(GoGame& game, int density, std::mt19937& rng) {
+    int size = game.getSize();
+    int target = size * size * density / 100;
+    std::uniform_int_distribution<int> pick(0, size - 1);
+    for (int attempt = 0; attempt < size * size * 20 && countStones(game.getBoard()) < target; ++attempt) {
+        int x = pick(rng), y = pick(rng);
+        if (game.getBoard().get(x, y) != Board::EMPTY) continue;
+        game.tryMove(x, y);
+    }
+}
+
+// 五子棋：黑白交替随机落子，跳过会连成五子的位置，保证判定要扫完整个棋盘
+Board randomGomokuBoard(int size, int density, std::mt19937& rng) {
+    Board board(size);
+    GomokuWinStrategy win;
+    int target = size * size * density / 100;
+    std::uniform_int_distribution<int> pick(0, size - 1);
+    uint8_t color = Board::BLACK;
+    for (int attempt = 0; attempt < size * size * 20 && countStones(board) < target; ++attempt) {
+        int x = pick(rng), y = pick(rng);
+        if (board.get(x, y) != Board::EMPTY) continue;
+        board.set(x, y, color);
+        if (win.checkWinAt(board, x, y) != PieceColor::NONE) {
+            board.set(x, y, Board::EMPTY);
+            continue;
+        }
+        color = (color == Board::BLACK) ? Board::WHITE : Board::BLACK;
+    }
+    return board;
+}
+
+// 按参数构造一盘已铺好棋子的对局，走子记录清空
+std::shared_ptr<AbstractGame> makeFilledGame(GameType type, int size, int density) {
+    std::mt19937 rng(size * 1000 + density);
+    if (type == GameType::GO) {
+        auto game = std::make_shared<GoGame>(size);
+        fillGo(*game, density, rng);
+        game->restoreMemento(game->createMemento());
+        return game;
+    }
+    auto game = std::make_shared<GomokuGame>(size);
+    game->restoreMemento(std::make_shared<GameMemento>(randomGomokuBoard(size, density, rng), PieceColor::BLACK, size, GameType::GOMOKU, 0));
+    return game;
+}
+
+// 在当前局面上随机挑一串合法着法，挑完后悔回原局面；重放同一串着法必然合法
+std::vector<std::pair<int, int>> pickMoves(AbstractGame& game, int count) {
+    std::mt19937 rng(12345);
+    int size = game.getSize();
+    std::uniform_int_distribution<int> pick(0, size - 1);
+    std::vector<std::pair<int, int>> moves;
+    for (int attempt = 0; attempt < size * size * 20 && (int)moves.size() < count; ++attempt) {
+        int x = pick(rng), y = pick(rng);
+        if (game.getBoard().get(x, y) != Board::EMPTY) continue;
+        if (game.tryMove(x, y) == MoveStatus::OK) moves.push_back({x, y});
+    }
+    for (size_t i = 0; i < moves.size(); ++i) game.undo();
+    return moves;
+}
+
+double seconds(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double>(b - a).count();
+}
+
+// ---------------- 落子与悔棋 ----------------
+
+// 每轮先计时落下一串着法，再（不计时）悔回原局面
+void BM_MakeMove(benchmark::State& state, GameType type) {
+    auto game = makeFilledGame(type, (int)state.range(0), (int)state.range(1));
+    auto moves = pickMoves(*game, BATCH);
+    if (moves.empty()) {
+        state.SkipWithError("没有可下的位置");
+        return;
+    }
+    for (auto _ : state) {
+        auto t0 = Clock::now();
+        for (const auto& m : moves) game->makeMove(m.first, m.second);
+        auto t1 = Clock::now();
+        state.SetIterationTime(seconds(t0, t1));
+        for (size_t i = 0; i < moves.size(); ++i) game->undo();
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)moves.size());
+}
+BENCHMARK_CAPTURE(BM_MakeMove, gomoku, GameType::GOMOKU)->Apply(sizeDensityArgs)->UseManualTime();
+BENCHMARK_CAPTURE(BM_MakeMove, go, GameType::GO)->Apply(sizeDensityArgs)->UseManualTime();
+
+// 每轮先（不计时）落下一串着法，再计时逐手悔回
+void BM_Undo(benchmark::State& state, GameType type) {
+    auto game = makeFilledGame(type, (int)state.range(0), (int)state.range(1));
+    auto moves = pickMoves(*game, BATCH);
+    if (moves.empty()) {
+        state.SkipWithError("没有可下的位置");
+        return;
+    }
+    for (auto _ : state) {
+        for (const auto& m : moves) game->makeMove(m.first, m.second);
+        auto t0 = Clock::now();
+        for (size_t i = 0; i < moves.size(); ++i) game->undo();
+        auto t1 = Clock::now();
+        state.SetIterationTime(seconds(t0, t1));
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)moves.size());
+}
+BENCHMARK_CAPTURE(BM_Undo, gomoku, GameType::GOMOKU)->Apply(sizeDensityArgs)->UseManualTime();
+BENCHMARK_CAPTURE(BM_Undo, go, GameType::GO)->Apply(sizeDensityArgs)->UseManualTime();
+
+// 轻量走子：每轮 play 一串着法再按相反顺序 unplay，整轮计时（计一次 play + unplay 为一项）
+void BM_PlayUnplay(benchmark::State& state, GameType type) {
+    auto game = makeFilledGame(type, (int)state.range(0), (int)state.range(1));
+    auto moves = pickMoves(*game, BATCH);
+    if (moves.empty()) {
+        state.SkipWithError("没有可下的位置");
+        return;
+    }
+    AbstractGame::UndoInfo undo[BATCH];
+    for (auto _ : state) {
+        for (size_t i = 0; i < moves.size(); ++i) undo[i] = game->play(moves[i].first, moves[i].second);
+        for (size_t i = moves.size(); i-- > 0;) game->unplay(undo[i]);
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)moves.size());
+}
+BENCHMARK_CAPTURE(BM_PlayUnplay, gomoku, GameType::GOMOKU)->Apply(sizeDensityArgs);
+BENCHMARK_CAPTURE(BM_PlayUnplay, go, GameType::GO)->Apply(sizeDensityArgs);
+
+// 一盘棋的完整生命周期：经工厂建局、落下一串着法、销毁
+// range(1) 为 0 时从全局堆分配，为 1 时从 GameArena 分配并在每局后 reset
+void BM_GameLifecycle(benchmark::State& state, GameType type) {
+    int size = (int)state.range(0);
+    std::shared_ptr<IGameFactory> factory;
+    if (type == GameType::GO) factory = std::make_shared<GoFactory>();
+    else factory = std::make_shared<GomokuFactory>();
+    auto moves = pickMoves(*factory->createGame(size), size * size / 2);
+    bool useArena = state.range(1) != 0;
+    GameArena arena;
+    for (auto _ : state) {
+        {
+            auto game = useArena ? factory->createGame(size, &arena) : factory->createGame(size);
+            for (const auto& m : moves) game->tryMove(m.first, m.second);
+            benchmark::DoNotOptimize(game->getHash());
+        }
+        if (useArena) arena.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)moves.size());
+    state.SetLabel(useArena ? "arena" : "heap");
+}
+BENCHMARK_CAPTURE(BM_GameLifecycle, gomoku, GameType::GOMOKU)->ArgsProduct({{9, 15, 19}, {0, 1}});
+BENCHMARK_CAPTURE(BM_GameLifecycle, go, GameType::GO)->ArgsProduct({{9, 15, 19}, {0, 1}});
+
+// 对局内核的整局随机对局：range(1) 为 1 时用工厂选出的编译期特化实例，为 0 时用运行期尺寸的通用实例
+template <class Rules>
+void BM_KernelRandomGame(benchmark::State& state) {
+    int size = (int)state.range(0);
+    std::unique_ptr<IGameKernel> kernel;
+    if (state.range(1)) kernel = createKernelFor<Rules>(size);
+    else kernel = std::make_unique<GameKernel<0, Rules>>(size);
+    uint64_t rng = 88172645463325252ULL;
+    int64_t moves = 0;
+    for (auto _ : state) {
+        kernel->reset();
+        moves += kernel->playRandomGame(rng, size * size * 3);
+    }
+    state.SetItemsProcessed(moves);
+    state.SetLabel(state.range(1) ? "specialized" : "generic");
+}
+BENCHMARK_TEMPLATE(BM_KernelRandomGame, GomokuRules)->ArgsProduct({{9, 15, 19}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_KernelRandomGame, GoRules)->ArgsProduct({{9, 13, 19}, {0, 1}});
+
+// ---------------- 观察者分发 ----------------
+
+// 模拟较慢的观察者：每次通知都把整盘转成文本（类似写日志或向观战者推送）
+class SpectatorObserver : public IGameObserver {
+    std::string line;
+    void dump(const Board& board) {
+        line.clear();
+        int size = board.getSize();
+        for (int i = 0; i < size; ++i)
+            for (int j = 0; j < size; ++j) line += (char)('0' + board.get(i, j));
+        benchmark::DoNotOptimize(line.data());
+    }
+public:
+    void onBoardUpdate(const Board& board) override { dump(board); }
+    void onCellsChanged(const Board& board, const CellChange*, int) override { dump(board); }
+    void onMessage(const std::string& msg) override { line = msg; }
+    void onGameOver(PieceColor) override {}
+};
+
+// mode: 0 同步调用, 1 异步(阻塞), 2 异步(丢弃)；只计落子时间
+void BM_ObserverDispatch(benchmark::State& state) {
+    int spectators = (int)state.range(0), mode = (int)state.range(1);
+    auto game = makeFilledGame(GameType::GO, 19, 30);
+    auto moves = pickMoves(*game, BATCH);
+
+    std::shared_ptr<AsyncObserver> async;
+    if (mode != 0) {
+        async = std::make_shared<AsyncObserver>(256, mode == 1 ? BackpressurePolicy::BLOCK : BackpressurePolicy::DROP);
+        game->addObserver(async);
+    }
+    for (int i = 0; i < spectators; ++i) {
+        auto obs = std::make_shared<SpectatorObserver>();
+        if (async) async->addObserver(obs);
+        else game->addObserver(obs);
+    }
+
+    for (auto _ : state) {
+        auto t0 = Clock::now();
+        for (const auto& m : moves) game->makeMove(m.first, m.second);
+        auto t1 = Clock::now();
+        state.SetIterationTime(seconds(t0, t1));
+        for (size_t i = 0; i < moves.size(); ++i) game->undo();
+    }
+    if (async) {
+        async->flush();
+        state.counters["dropped"] = (double)async->getDropped();
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)moves.size());
+}
+BENCHMARK(BM_ObserverDispatch)->ArgNames({"spectators", "mode"})->ArgsProduct({{0, 1, 4, 16}, {0, 1, 2}})->UseManualTime();
+
+// ---------------- 指令解析与非法落子 ----------------
+
+void BM_ParseCommand(benchmark::State& state) {
+    const std::string_view lines[] = {"move 3 4", "genmove 500 4", "sgfload games.sgf 12", "undo", "start go 19"};
+    size_t k = 0;
+    for (auto _ : state) {
+        Command cmd = parseCommand(lines[k]);
+        int v = 0;
+        cmd.intArg(0, v);
+        benchmark::DoNotOptimize(cmd.id);
+        benchmark::DoNotOptimize(v);
+        if (++k == 5) k = 0;
+    }
+}
+BENCHMARK(BM_ParseCommand);
+
+// 在已有棋子处落子：throwing=1 走 makeMove 抛异常，0 走 tryMove 返回状态
+void BM_RejectMove(benchmark::State& state) {
+    auto game = makeFilledGame(GameType::GO, 19, 30);
+    int x = 0, y = 0;
+    while (game->getBoard().get(x, y) == Board::EMPTY) {
+        if (++y == 19) y = 0, ++x;
+    }
+    bool throwing = state.range(0) != 0;
+    for (auto _ : state) {
+        if (throwing) {
+            try {
+                game->makeMove(x, y);
+            } catch (const GameException& e) {
+                benchmark::DoNotOptimize(e.what());
+            }
+        } else {
+            benchmark::DoNotOptimize(game->tryMove(x, y));
+        }
+    }
+}
+BENCHMARK(BM_RejectMove)->ArgName("throwing")->Arg(0)->Arg(1);
+
+// 生成全部合法着法：range(2) 为 0 取全盘，1 只取棋子两格内
+void BM_GenerateMoves(benchmark::State& state, GameType type) {
+    auto game = makeFilledGame(type, (int)state.range(0), (int)state.range(1));
+    MoveGenMode mode = state.range(2) ? MoveGenMode::NEAR_STONES : MoveGenMode::ALL;
+    MoveList moves;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(game->generateMoves(moves, mode));
+    }
+    state.SetItemsProcessed(state.iterations() * moves.count);
+}
+BENCHMARK_CAPTURE(BM_GenerateMoves, gomoku, GameType::GOMOKU)->ArgsProduct({{9, 19}, {5, 30}, {0, 1}});
+BENCHMARK_CAPTURE(BM_GenerateMoves, go, GameType::GO)->ArgsProduct({{9, 19}, {5, 30}, {0, 1}});
+
+// ---------------- 围棋提子 ----------------
+
+// 白棋占满前 rows 行（留出右上角一口气），黑棋封住第 rows 行；黑下右上角一次提掉整块白棋
+// rows = 0 时退化为单子提：白子在角上，黑下一手提掉
+void BM_GoCapture(benchmark::State& state) {
+    int size = (int)state.range(0), rows = (int)state.range(1);
+    Board board(size);
+    int px, py;
+    if (rows == 0) {
+        board.set(0, 0, Board::WHITE);
+        board.set(0, 1, Board::BLACK);
+        px = 1, py = 0;
+    } else {
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < size; ++j) board.set(i, j, Board::WHITE);
+        for (int j = 0; j < size; ++j) board.set(rows, j, Board::BLACK);
+        board.set(0, size - 1, Board::EMPTY);
+        px = 0, py = size - 1;
+    }
+    GoGame game(size);
+    game.restoreMemento(std::make_shared<GameMemento>(board, PieceColor::BLACK, size, GameType::GO, 0));
+
+    int captured = 0;
+    for (auto _ : state) {
+        auto t0 = Clock::now();
+        game.makeMove(px, py);
+        auto t1 = Clock::now();
+        state.SetIterationTime(seconds(t0, t1));
+        captured = countStones(board) - countStones(game.getBoard()) + 1;
+        game.undo();
+    }
+    state.counters["captured"] = captured;
+}
+
+void captureArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"size", "rows"});
+    for (int s : SIZES) {
+        b->Args({s, 0});
+        b->Args({s, 1});
+        b->Args({s, s / 2});
+        b->Args({s, s - 2});
+    }
+}
+BENCHMARK(BM_GoCapture)->Apply(captureArgs)->UseManualTime();
+
+// ---------------- 胜负判定与结算 ----------------
+
+void BM_GomokuCheckWin(benchmark::State& state) {
+    std::mt19937 rng((unsigned)(state.range(0) * 1000 + state.range(1)));
+    Board board = randomGomokuBoard((int)state.range(0), (int)state.range(1), rng);
+    GomokuWinStrategy win;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(win.checkWin(board));
+    }
+}
+BENCHMARK(BM_GomokuCheckWin)->Apply(sizeDensityArgs);
+
+// 落子点附近的局部判定（makeMove 实际走的路径），在所有已落子的格子上轮流判定
+void BM_GomokuCheckWinAt(benchmark::State& state) {
+    int size = (int)state.range(0);
+    std::mt19937 rng((unsigned)(size * 1000 + state.range(1)));
+    Board board = randomGomokuBoard(size, (int)state.range(1), rng);
+    std::vector<std::pair<int, int>> stones;
+    for (int i = 0; i < size; ++i)
+        for (int j = 0; j < size; ++j)
+            if (board.get(i, j) != Board::EMPTY) stones.push_back({i, j});
+    GomokuWinStrategy win;
+    size_t k = 0;
+    for (auto _ : state) {
+        const auto& p = stones[k];
+        benchmark::DoNotOptimize(win.checkWinAt(board, p.first, p.second));
+        if (++k == stones.size()) k = 0;
+    }
+}
+BENCHMARK(BM_GomokuCheckWinAt)->Apply(sizeDensityArgs);
+
+// 位棋盘内核对比：range(2) 为 0 走标量内核，为 1 走 AVX2 内核（CPU 不支持时跳过）
+const GomokuKernel* kernelArg(benchmark::State& state) {
+    if (state.range(2) == 0) return &GomokuKernel::scalar();
+    const GomokuKernel* k = GomokuKernel::avx2();
+    if (!k) state.SkipWithError("CPU 不支持 AVX2");
+    return k;
+}
+
+void kernelArgs(benchmark::internal::Benchmark* b) {
+    for (int size : {15, 19})
+        for (int density : {10, 30, 60})
+            for (int k : {0, 1}) b->Args({size, density, k});
+}
+
+// 载入 + 双方连五判定，即 checkWin 的完整开销
+void BM_GomokuKernelFive(benchmark::State& state) {
+    const GomokuKernel* k = kernelArg(state);
+    if (!k) return;
+    std::mt19937 rng((unsigned)(state.range(0) * 1000 + state.range(1)));
+    Board board = randomGomokuBoard((int)state.range(0), (int)state.range(1), rng);
+    GomokuBitboard bb;
+    for (auto _ : state) {
+        k->load(board, bb);
+        benchmark::DoNotOptimize(k->hasFive(bb.black) || k->hasFive(bb.white));
+    }
+    state.SetLabel(k->name);
+}
+BENCHMARK(BM_GomokuKernelFive)->Apply(kernelArgs);
+
+// 载入 + 双方成五点统计
+void BM_GomokuKernelThreats(benchmark::State& state) {
+    const GomokuKernel* k = kernelArg(state);
+    if (!k) return;
+    std::mt19937 rng((unsigned)(state.range(0) * 1000 + state.range(1)));
+    Board board = randomGomokuBoard((int)state.range(0), (int)state.range(1), rng);
+    GomokuBitboard bb;
+    BitPlane points;
+    for (auto _ : state) {
+        k->load(board, bb);
+        int n = k->winningPoints(bb.black, bb.empty, points);
+        n += k->winningPoints(bb.white, bb.empty, points);
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetLabel(k->name);
+}
+BENCHMARK(BM_GomokuKernelThreats)->Apply(kernelArgs);
+
+// 双方停手后的数子结算（含结果文本）
+void BM_GoScore(benchmark::State& state) {
+    auto game = makeFilledGame(GameType::GO, (int)state.range(0), (int)state.range(1));
+    Board board = game->getBoard();
+    GoWinStrategy win;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(win.checkWin(board, true));
+    }
+}
+BENCHMARK(BM_GoScore)->Apply(sizeDensityArgs);
+
+// 只数子（连通分量划分空地），不生成描述文本
+void BM_GoCountArea(benchmark::State& state) {
+    auto game = makeFilledGame(GameType::GO, (int)state.range(0), (int)state.range(1));
+    Board board = game->getBoard();
+    GoScorer scorer;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scorer.countArea(board));
+    }
+}
+BENCHMARK(BM_GoCountArea)->Apply(sizeDensityArgs);
+
+// 死子估计：19 路，range(0) 次随机对局，range(1) 个线程
+void BM_GoOwnership(benchmark::State& state) {
+    auto game = makeFilledGame(GameType::GO, 19, 60);
+    Board board = game->getBoard();
+    OwnershipConfig cfg;
+    cfg.playouts = (int)state.range(0);
+    cfg.threads = (int)state.range(1);
+    OwnershipMap map;
+    for (auto _ : state) {
+        GoScorer::estimateOwnership(board, cfg, map);
+        benchmark::DoNotOptimize(map.own[0]);
+    }
+    state.SetItemsProcessed(state.iterations() * cfg.playouts);
+}
+BENCHMARK(BM_GoOwnership)->Args({64, 1})->Args({256, 1})->Args({256, 0})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// ---------------- 存档与读档 ----------------
+
+// 不清空走子记录，让二进制存档也带上着法
+std::shared_ptr<GameMemento> makeMemento(GameType type, int size, int density) {
+    std::mt19937 rng(size * 1000 + density);
+    if (type == GameType::GO) {
+        GoGame game(size);
+        fillGo(game, density, rng);
+        return game.createMemento();
+    }
+    return std::make_shared<GameMemento>(randomGomokuBoard(size, density, rng), PieceColor::BLACK, size, GameType::GOMOKU, 0);
+}
+
+void BM_MementoSerialize(benchmark::State& state) {
+    auto mem = makeMemento(GameType::GO, (int)state.range(0), (int)state.range(1));
+    size_t bytes = 0;
+    for (auto _ : state) {
+        std::string s = mem->serialize();
+        bytes += s.size();
+        benchmark::DoNotOptimize(s);
+    }
+    state.SetBytesProcessed((int64_t)bytes);
+}
+BENCHMARK(BM_MementoSerialize)->Apply(sizeDensityArgs);
+
+void BM_MementoDeserialize(benchmark::State& state) {
+    std::string text = makeMemento(GameType::GO, (int)state.range(0), (int)state.range(1))->serialize();
+    for (auto _ : state) {
+        std::istringstream is(text);
+        benchmark::DoNotOptimize(GameMemento::deserialize(is));
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)text.size());
+}
+BENCHMARK(BM_MementoDeserialize)->Apply(sizeDensityArgs);
+
+void BM_MementoSerializeBinary(benchmark::State& state) {
+    auto mem = makeMemento(GameType::GO, (int)state.range(0), (int)state.range(1));
+    size_t bytes = 0;
+    for (auto _ : state) {
+        std::string s = mem->serializeBinary();
+        bytes += s.size();
+        benchmark::DoNotOptimize(s);
+    }
+    state.SetBytesProcessed((int64_t)bytes);
+}
+BENCHMARK(BM_MementoSerializeBinary)->Apply(sizeDensityArgs);
+
+void BM_MementoDeserializeBinary(benchmark::State& state) {
+    std::string data = makeMemento(GameType::GO, (int)state.range(0), (int)state.range(1))->serializeBinary();
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data.data());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GameMemento::deserializeBinary(p, data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)data.size());
+}
+BENCHMARK(BM_MementoDeserializeBinary)->Apply(sizeDensityArgs);
+
+// ---------------- 开局库 ----------------
+
+// 查询开局库：range(0) 路围棋，库由 256 局随机对局的前 16 步建成，查询第 range(1) 步的局面（8 种对称方向轮流）
+void BM_BookProbe(benchmark::State& state) {
+    int size = (int)state.range(0), ply = (int)state.range(1);
+    std::mt19937 rng(size);
+    OpeningBookBuilder builder(16);
+    std::vector<Board> queries;
+    for (int g = 0; g < 256; ++g) {
+        GoGame game(size);
+        fillGo(game, 100 * 16 / (size * size) + 1, rng);
+        builder.addGame(game);
+        if (queries.size() < 8 && (int)game.getHistory().size() > ply) {
+            // 把第 ply 步时的局面换成第 queries.size() 种对称方向
+            GoGame replay(size);
+            for (int k = 0; k < ply; ++k) {
+                int idx = game.getHistory()[k].idx;
+                replay.makeMove(Board::rowOf(idx), Board::colOf(idx));
+            }
+            Board b(size);
+            int t = (int)queries.size();
+            for (int i = 0; i < size; ++i) {
+                for (int j = 0; j < size; ++j) {
+                    int x, y;
+                    OpeningBook::transform(t, size, i, j, x, y);
+                    b.set(x, y, replay.getBoard().get(i, j));
+                }
+            }
+            queries.push_back(b);
+        }
+    }
+    std::string path = (std::filesystem::temp_directory_path() / "chess_bench.book").string();
+    builder.write(path);
+    OpeningBook book(path);
+    std::remove(path.c_str()); // 已映射，删除目录项不影响读取
+
+    PieceColor toMove = (ply % 2 == 0) ? PieceColor::BLACK : PieceColor::WHITE;
+    OpeningBook::BookMove bm;
+    size_t i = 0, hits = 0;
+    for (auto _ : state) {
+        hits += book.probe(queries[i++ % queries.size()], GameType::GO, toMove, bm);
+        benchmark::DoNotOptimize(bm);
+    }
+    if (hits != (size_t)state.iterations()) state.SkipWithError("开局库未命中");
+}
+BENCHMARK(BM_BookProbe)->ArgsProduct({{9, 19}, {0, 4, 12}});
+
+} // namespace
+
+// 未指定输出格式时默认输出 JSON
+int main(int argc, char** argv) {
+    std::vector<char*> args(argv, argv + argc);
+    bool hasFormat = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--benchmark_format", 18) == 0) hasFormat = true;
+    }
+    static char jsonFormat[] = "--benchmark_format=json";
+    if (!hasFormat) args.push_back(jsonFormat);
+    int n = (int)args.size();
+
+    benchmark::Initialize(&n, args.data());
+    if (benchmark::ReportUnrecognizedArguments(n, args.data())) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
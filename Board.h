@@ -0,0 +1,72 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <cstdint>
+#include <cstring>
+#include "GameTypes.h"
+
+// 棋盘存储：一块连续的 uint8_t 缓冲区，四周带一圈哨兵边框
+// 固定按 19x19 的最大尺寸分配，拷贝即一次内存复制，没有逐行的堆分配
+class Board {
+public:
+    static constexpr int MAX_SIZE = 19;
+    static constexpr int STRIDE = MAX_SIZE + 2;      // 每行宽度（含左右边框）
+    static constexpr int CAPACITY = STRIDE * STRIDE; // 缓冲区总格数
+
+    // 格子取值：0空, 1黑, 2白, 3边框
+    static constexpr uint8_t EMPTY = 0;
+    static constexpr uint8_t BLACK = 1;
+    static constexpr uint8_t WHITE = 2;
+    static constexpr uint8_t BORDER = 3;
+
+private:
+    int size;
+    uint8_t cells[CAPACITY];
+
+public:
+    explicit Board(int s = 0) : size(s) {
+        if (size < 0 || size > MAX_SIZE) throw GameException("棋盘尺寸超出支持范围");
+        // 先全部标记为边框，再把有效区域清空
+        std::memset(cells, BORDER, sizeof(cells));
+        for (int i = 0; i < size; ++i) {
+            std::memset(cells + index(i, 0), EMPTY, size);
+        }
+    }
+
+    int getSize() const { return size; }
+
+    // 坐标 (x, y) 到缓冲区下标的映射，越界一格仍落在边框上
+    static constexpr int index(int x, int y) { return (x + 1) * STRIDE + (y + 1); }
+    static constexpr int rowOf(int idx) { return idx / STRIDE - 1; }
+    static constexpr int colOf(int idx) { return idx % STRIDE - 1; }
+
+    bool inBounds(int x, int y) const { return x >= 0 && x < size && y >= 0 && y < size; }
+
+    uint8_t get(int x, int y) const { return cells[index(x, y)]; }
+    void set(int x, int y, uint8_t v) { cells[index(x, y)] = v; }
+
+    // 按下标访问，供需要走邻格偏移（±1, ±STRIDE）的热路径使用
+    uint8_t at(int idx) const { return cells[idx]; }
+    void setAt(int idx, uint8_t v) { cells[idx] = v; }
+
+    const uint8_t* data() const { return cells; }
+
+    bool operator==(const Board& o) const {
+        return size == o.size && std::memcmp(cells, o.cells, sizeof(cells)) == 0;
+    }
+    bool operator!=(const Board& o) const { return !(*this == o); }
+
+    // 工具函数：颜色与格子取值互转
+    static uint8_t fromColor(PieceColor c) {
+        if (c == PieceColor::BLACK) return BLACK;
+        if (c == PieceColor::WHITE) return WHITE;
+        return EMPTY;
+    }
+    static PieceColor toColor(uint8_t v) {
+        if (v == BLACK) return PieceColor::BLACK;
+        if (v == WHITE) return PieceColor::WHITE;
+        return PieceColor::NONE;
+    }
+};
+
+#endif // BOARD_H
@@ -0,0 +1,90 @@
+/*
+ * 开局库离线构建入口：读取棋谱语料（.sgf 棋谱集合或 .gmb 二进制存档），统计开局局面并写出开局库
+ * 用法: book_builder --out file [--plies N] [--min-games N] 输入文件...
+ * 示例: batch_runner --game gomoku --games 10000 --engine --sgf corpus.sgf
+ *       book_builder --out gomoku.book --plies 12 --min-games 3 corpus.sgf
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "OpeningBook.h"
+#include "GameArchive.h"
+#include "Sgf.h"
+
+int main(int argc, char* argv[]) {
+    std::string outPath;
+    int plies = 20;
+    int minGames = 1;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "缺少参数值: " << arg << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--out") {
+            outPath = value();
+        } else if (arg == "--plies") {
+            plies = std::atoi(value().c_str());
+        } else if (arg == "--min-games") {
+            minGames = std::atoi(value().c_str());
+        } else if (arg.size() > 2 && arg.compare(0, 2, "--") == 0) {
+            std::cerr << "未知参数: " << arg << "\n";
+            return 2;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (outPath.empty() || inputs.empty()) {
+        std::cerr << "用法: book_builder --out file [--plies N] [--min-games N] 输入文件...\n";
+        return 2;
+    }
+    if (plies < 1 || minGames < 1) {
+        std::cerr << "--plies 与 --min-games 必须为正数\n";
+        return 2;
+    }
+
+    try {
+        OpeningBookBuilder builder(plies);
+        size_t skipped = 0;
+
+        for (const std::string& path : inputs) {
+            bool binary = path.size() > 4 && path.compare(path.size() - 4, 4, ".gmb") == 0;
+            if (binary) {
+                GameArchive archive(path);
+                GameRecordView rec;
+                while (archive.next(rec)) {
+                    if (!builder.addRecord(rec)) skipped++;
+                }
+            } else {
+                // 棋谱集合中单局格式有误时跳过该局，继续读后面的对局
+                SgfReader reader(path);
+                for (;;) {
+                    std::shared_ptr<AbstractGame> game;
+                    try {
+                        game = reader.nextGame();
+                    } catch (const GameException&) {
+                        skipped++;
+                        continue;
+                    }
+                    if (!game) break;
+                    if (!builder.addGame(*game)) skipped++;
+                }
+            }
+        }
+
+        size_t written = builder.write(outPath, (uint32_t)minGames);
+        std::cout << "对局 " << builder.getGamesAdded() << " 局 (跳过 " << skipped << " 局), 局面 "
+                  << builder.getPositionCount() << " 个, 写入 " << written << " 条 -> " << outPath << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "错误: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
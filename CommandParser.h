@@ -0,0 +1,88 @@
+#ifndef COMMANDPARSER_H
+#define COMMANDPARSER_H
+
+#include <charconv>
+#include <string_view>
+
+// 指令编号：解析时把指令名映射为编号，分发时按编号 switch
+enum class CommandId { EMPTY, UNKNOWN, START, MOVE, PASS, UNDO, RESIGN, SAVE, LOAD, SGFSAVE, SGFLOAD, GENMOVE, HINT, HELP, STATS, BOOK, EXIT };
+
+// 解析后的一行指令：指令名与参数都是指向输入行的 string_view，解析过程不分配内存
+struct Command {
+    static constexpr int MAX_ARGS = 4; // 多余的参数忽略
+
+    CommandId id = CommandId::EMPTY;
+    std::string_view name;
+    std::string_view args[MAX_ARGS];
+    int argc = 0;
+
+    std::string_view arg(int i) const { return i < argc ? args[i] : std::string_view(); }
+
+    // 第 i 个参数按十进制整数解析，缺失或不是完整的整数时返回 false 且不改动 out
+    bool intArg(int i, int& out) const {
+        std::string_view s = arg(i);
+        if (s.empty()) return false;
+        int v;
+        auto res = std::from_chars(s.data(), s.data() + s.size(), v);
+        if (res.ec != std::errc() || res.ptr != s.data() + s.size()) return false;
+        out = v;
+        return true;
+    }
+};
+
+// 指令名到编号：先按长度分支，再逐个比较同长度的候选
+inline CommandId lookupCommand(std::string_view name) {
+    switch (name.size()) {
+    case 4:
+        if (name == "move") return CommandId::MOVE;
+        if (name == "pass") return CommandId::PASS;
+        if (name == "undo") return CommandId::UNDO;
+        if (name == "save") return CommandId::SAVE;
+        if (name == "load") return CommandId::LOAD;
+        if (name == "hint") return CommandId::HINT;
+        if (name == "help") return CommandId::HELP;
+        if (name == "exit") return CommandId::EXIT;
+        if (name == "book") return CommandId::BOOK;
+        break;
+    case 5:
+        if (name == "start") return CommandId::START;
+        if (name == "stats") return CommandId::STATS;
+        break;
+    case 6:
+        if (name == "resign") return CommandId::RESIGN;
+        break;
+    case 7:
+        if (name == "sgfsave") return CommandId::SGFSAVE;
+        if (name == "sgfload") return CommandId::SGFLOAD;
+        if (name == "genmove") return CommandId::GENMOVE;
+        break;
+    }
+    return CommandId::UNKNOWN;
+}
+
+// 按空白切分一行指令
+inline Command parseCommand(std::string_view line) {
+    Command cmd;
+    size_t pos = 0, n = line.size();
+    auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+    bool first = true;
+    while (pos < n) {
+        while (pos < n && isSpace(line[pos])) ++pos;
+        if (pos >= n) break;
+        size_t start = pos;
+        while (pos < n && !isSpace(line[pos])) ++pos;
+        std::string_view token = line.substr(start, pos - start);
+        if (first) {
+            cmd.name = token;
+            first = false;
+        } else if (cmd.argc < Command::MAX_ARGS) {
+            cmd.args[cmd.argc++] = token;
+        } else {
+            break;
+        }
+    }
+    if (!first) cmd.id = lookupCommand(cmd.name);
+    return cmd;
+}
+
+#endif // COMMANDPARSER_H
@@ -1,53 +1,51 @@
 #include "ConsoleUI.h"
-#include <iostream>
-#include <cstdlib>
+#include "Metrics.h"
 
-// 캯
+// 构造函数
 ConsoleUI::ConsoleUI(std::shared_ptr<UIComponent> root,
           std::shared_ptr<BoardComponent> board,
           std::shared_ptr<TextComponent> hint,
           std::shared_ptr<TextComponent> status)
     : rootComponent(root), boardRef(board), hintRef(hint), statusRef(status) {}
 
-// IGameObserver ʵ
-void ConsoleUI::onBoardUpdate(const std::vector<std::vector<int>>& board, int size) {
-    boardRef->update(board, size);
+// IGameObserver 实现
+void ConsoleUI::onBoardUpdate(const Board& board) {
+    boardRef->update(board);
+}
+
+// 只改动变化的格子，不再整盘复制
+void ConsoleUI::onCellsChanged(const Board& board, const CellChange* changes, int count) {
+    for (int i = 0; i < count; ++i) boardRef->updateCell(changes[i].x, changes[i].y, changes[i].value);
 }
 
 void ConsoleUI::onMessage(const std::string& msg) {
-    hintRef->setText("[ϵͳϢ] " + msg);
+    hintRef->setText("[系统消息] " + msg);
 }
 
 void ConsoleUI::onGameOver(PieceColor winner) {
     std::string w = colorToString(winner);
-    statusRef->setText("Ϸ (ʤ: " + w + ")");
+    statusRef->setText("游戏结束 (胜者: " + w + ")");
 }
 
-// UI Ʒ
+// UI 控制方法
 void ConsoleUI::updateGameStatus(const std::string& gameName) {
-    std::string display = "ǰϷ: <" + gameName + "> ";
+    std::string display = "当前游戏: <" + gameName + "> ";
     statusRef->setText(display);
 }
 
 void ConsoleUI::toggleHints() {
-    static bool v = true;
-    v = !v;
-    hintRef->setVisible(v);
-    render();
+    hintsVisible = !hintsVisible;
+    hintRef->setVisible(hintsVisible);
 }
 
 void ConsoleUI::render() {
-    // 
-    #ifdef _WIN32
-        system("cls");
-    #else
-        system("clear");
-    #endif
-    
-    // ģʽһãݹ UI 
+    METRIC_SCOPE(Metric::RENDER);
+    // 组合模式：一键调用，递归绘制整个 UI 树到帧缓冲
+    TextFrame& frame = renderer.beginFrame();
     if (rootComponent) {
-        rootComponent->draw();
+        rootComponent->draw(frame);
     }
-    
-    std::cout << "ָ (help 鿴): ";
+
+    // 与上一帧比较，一次写出差异
+    renderer.present("请输入指令 (help 查看帮助): ");
 }
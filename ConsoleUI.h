@@ -5,33 +5,41 @@
 #include <string>
 #include "Observer.h"
 #include "UIComponent.h"
+#include "TerminalRenderer.h"
 
-// ̨UIࣨʵֹ۲߽ӿڣ
+// 控制台UI类（实现观察者接口）
 class ConsoleUI : public IGameObserver {
 private:
-    // ģʽĺģֻһڵ㼴Ⱦ
+    // 组合模式的核心：只持有一个根节点即可完成渲染
     std::shared_ptr<UIComponent> rootComponent;
 
-    // Ϊܹݣض
+    // 为了能够更新数据，持有特定组件的引用
     std::shared_ptr<BoardComponent> boardRef;
     std::shared_ptr<TextComponent> hintRef;
     std::shared_ptr<TextComponent> statusRef;
 
+    // 差分渲染：组件树绘制到帧缓冲，只把与上一帧不同的部分写到终端
+    TerminalRenderer renderer;
+    bool hintsVisible = true;
+
 public:
     ConsoleUI(std::shared_ptr<UIComponent> root,
               std::shared_ptr<BoardComponent> board,
               std::shared_ptr<TextComponent> hint,
               std::shared_ptr<TextComponent> status);
 
-    // IGameObserver ʵ
-    void onBoardUpdate(const std::vector<std::vector<int>>& board, int size) override;
+    // IGameObserver 实现
+    void onBoardUpdate(const Board& board) override;
+    void onCellsChanged(const Board& board, const CellChange* changes, int count) override;
     void onMessage(const std::string& msg) override;
     void onGameOver(PieceColor winner) override;
     
-    // UI Ʒ
+    // UI 控制方法
     void updateGameStatus(const std::string& gameName);
     void toggleHints();
     void render();
+    // 渲染结果追加到给定缓冲区而不是标准输出（服务器会话使用）
+    void setOutput(std::string* buffer) { renderer.setOutput(buffer); }
 };
 
 #endif // CONSOLEUI_H
@@ -0,0 +1,17 @@
+#include "GameArchive.h"
+#include <fstream>
+
+// 读取下一条记录，已到末尾返回 false
+bool GameArchive::next(GameRecordView& rec) {
+    if (offset >= file.getLength()) return false;
+    offset += GameRecordView::parse(file.getData() + offset, file.getLength() - offset, rec);
+    return true;
+}
+
+// 把一条记录追加到存档文件末尾
+void GameArchive::append(const std::string& path, const GameMemento& mem) {
+    std::ofstream ofs(path, std::ios::binary | std::ios::app);
+    if (!ofs) throw GameException("文件创建失败");
+    std::string bytes = mem.serializeBinary();
+    ofs.write(bytes.data(), bytes.size());
+}
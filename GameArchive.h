@@ -0,0 +1,31 @@
+#ifndef GAMEARCHIVE_H
+#define GAMEARCHIVE_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "GameMemento.h"
+#include "MappedFile.h"
+
+// 二进制存档集合：把整个文件映射到内存，逐条遍历其中的记录
+// 遍历得到的 GameRecordView 直接指向映射区域，存档对象销毁前有效
+class GameArchive {
+private:
+    MappedFile file;
+    size_t offset = 0;
+
+public:
+    explicit GameArchive(const std::string& path) : file(path) {}
+
+    // 读取下一条记录，已到末尾返回 false
+    bool next(GameRecordView& rec);
+    void rewind() { offset = 0; }
+
+    const uint8_t* getData() const { return file.getData(); }
+    size_t getLength() const { return file.getLength(); }
+
+    // 把一条记录追加到存档文件末尾
+    static void append(const std::string& path, const GameMemento& mem);
+};
+
+#endif // GAMEARCHIVE_H
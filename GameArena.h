@@ -0,0 +1,101 @@
+#ifndef GAMEARENA_H
+#define GAMEARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+// 对局内存区：从预先申请的大块内存中顺序切分，单个释放是空操作
+// 一盘棋的对象、策略、走子记录与局面表都从这里分配；对局销毁后 reset() 一次收回全部分配，
+// 大块内存保留给下一盘复用，稳定后批量对局不再调用全局 malloc，各线程各用一个内存区，互不争用
+// 不是线程安全的：一个内存区只能由一个线程使用
+class GameArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+    std::vector<Block> chunks; // 标准大小的块，reset 后保留
+    std::vector<Block> large;  // 超过块大小的单次分配，reset 时归还
+    size_t current = 0;        // 正在切分的块
+    size_t offset = 0;         // 当前块内已用字节数
+    size_t used = 0;           // 自上次 reset 以来分配的字节数
+
+    static char* allocateBlock(size_t bytes) {
+        void* p = std::malloc(bytes);
+        if (!p) throw std::bad_alloc();
+        return static_cast<char*>(p);
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t align) override {
+        used += bytes;
+        if (bytes + align > CHUNK_SIZE / 4) {
+            // malloc 的结果按 max_align_t 对齐，更高的对齐要求多申请 align 字节自行调整
+            char* p = allocateBlock(bytes + align);
+            large.push_back({p, bytes + align});
+            size_t mis = reinterpret_cast<uintptr_t>(p) & (align - 1);
+            return p + (mis ? align - mis : 0);
+        }
+        while (true) {
+            if (current < chunks.size()) {
+                Block& b = chunks[current];
+                size_t mis = reinterpret_cast<uintptr_t>(b.data + offset) & (align - 1);
+                size_t start = offset + (mis ? align - mis : 0);
+                if (start + bytes <= b.size) {
+                    offset = start + bytes;
+                    return b.data + start;
+                }
+                ++current;
+                offset = 0;
+                continue;
+            }
+            chunks.push_back({allocateBlock(CHUNK_SIZE), CHUNK_SIZE});
+        }
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+    GameArena() = default;
+    GameArena(const GameArena&) = delete;
+    GameArena& operator=(const GameArena&) = delete;
+    ~GameArena() { release(); }
+
+    // 收回全部分配；调用前必须确保从本内存区分配的对象都已销毁
+    void reset() {
+        for (Block& b : large) std::free(b.data);
+        large.clear();
+        current = 0;
+        offset = 0;
+        used = 0;
+    }
+
+    // 收回全部分配并把大块内存还给系统
+    void release() {
+        reset();
+        for (Block& b : chunks) std::free(b.data);
+        chunks.clear();
+    }
+
+    size_t bytesUsed() const { return used; }
+    size_t bytesReserved() const { return chunks.size() * CHUNK_SIZE; }
+};
+
+// 在指定内存资源上创建 shared_ptr 管理的对象，控制块与对象一起分配
+template <class T, class... Args>
+std::shared_ptr<T> allocateShared(std::pmr::memory_resource* mem, Args&&... args) {
+    return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(mem), std::forward<Args>(args)...);
+}
+
+#endif // GAMEARENA_H
@@ -5,28 +5,46 @@
 #include "AbstractGame.h"
 #include "GomokuGame.h"
 #include "GoGame.h"
+#include "GameKernel.h"
 
-// 󹤳ӿ
+// 按尺寸选择对局内核的实例：9/13/15/19 路为编译期特化版本，其余尺寸使用运行期尺寸的通用版本
+template <class Rules>
+std::unique_ptr<IGameKernel> createKernelFor(int size) {
+    switch (size) {
+    case 9: return std::make_unique<GameKernel<9, Rules>>();
+    case 13: return std::make_unique<GameKernel<13, Rules>>();
+    case 15: return std::make_unique<GameKernel<15, Rules>>();
+    case 19: return std::make_unique<GameKernel<19, Rules>>();
+    default: return std::make_unique<GameKernel<0, Rules>>(size);
+    }
+}
+
+// 抽象工厂接口
+// mem 为对局及其内部容器的内存来源：默认为全局堆；传入 GameArena 时，对局销毁后由持有者 reset 内存区
 class IGameFactory {
 public:
-    virtual std::shared_ptr<AbstractGame> createGame(int size) = 0;
+    virtual std::shared_ptr<AbstractGame> createGame(int size, std::pmr::memory_resource* mem = std::pmr::get_default_resource()) = 0;
+    // 无界面的精简对局内核，供批量模拟使用
+    virtual std::unique_ptr<IGameKernel> createKernel(int size) = 0;
     virtual ~IGameFactory() = default;
 };
 
-// 幤幤
+// 具体工厂：五子棋工厂
 class GomokuFactory : public IGameFactory {
 public:
-    std::shared_ptr<AbstractGame> createGame(int size) override {
-        return std::make_shared<GomokuGame>(size);
+    std::shared_ptr<AbstractGame> createGame(int size, std::pmr::memory_resource* mem = std::pmr::get_default_resource()) override {
+        return allocateShared<GomokuGame>(mem, size, mem);
     }
+    std::unique_ptr<IGameKernel> createKernel(int size) override { return createKernelFor<GomokuRules>(size); }
 };
 
-// 幤Χ幤
+// 具体工厂：围棋工厂
 class GoFactory : public IGameFactory {
 public:
-    std::shared_ptr<AbstractGame> createGame(int size) override {
-        return std::make_shared<GoGame>(size);
+    std::shared_ptr<AbstractGame> createGame(int size, std::pmr::memory_resource* mem = std::pmr::get_default_resource()) override {
+        return allocateShared<GoGame>(mem, size, mem);
     }
+    std::unique_ptr<IGameKernel> createKernel(int size) override { return createKernelFor<GoRules>(size); }
 };
 
 #endif // GAMEFACTORY_H
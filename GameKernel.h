@@ -0,0 +1,238 @@
+#ifndef GAMEKERNEL_H
+#define GAMEKERNEL_H
+
+#include <cstdint>
+#include "Board.h"
+#include "GameTypes.h"
+#include "GoChains.h"
+#include "GoStrategy.h"
+#include "GomokuStrategy.h"
+
+// 对局内核：不经过策略对象、观察者与走子记录的精简对局，供批量模拟使用
+// 规则在编译期静态绑定，棋盘尺寸可作为模板参数：尺寸固定时循环上下界、棋盘下标范围都是编译期常量
+// 外部通过 IGameKernel 的虚函数使用（每盘一次虚调用进入 playRandomGame，整局随机对局都在内核内完成）
+
+// 五子棋规则：无提子、无禁手，落子后只检查经过该点的四条线
+struct GomokuRules {
+    static constexpr GameType TYPE = GameType::GOMOKU;
+
+    struct State {
+        void reset(const Board&) {}
+    };
+
+    static MoveStatus check(const Board&, const State&, int, uint8_t) { return MoveStatus::OK; }
+
+    static int apply(Board& board, State&, int idx, uint8_t me) {
+        board.setAt(idx, me);
+        return 0;
+    }
+
+    // 与 GomokuGame 共用同一份连五判定
+    static bool wins(const Board& board, int idx) { return GomokuWinStrategy::fiveThrough(board, idx) != PieceColor::NONE; }
+
+    // 随机对局的候选点：任何空点
+    static bool playoutCandidate(const Board&, int, uint8_t) { return true; }
+};
+
+// 围棋规则：禁自杀 + 单劫（与 GoBoard 相同，不做全局同形判断），终局数子
+// GoGame 按局面历史禁止全局同形，两者只在劫争上有差别：三劫、循环劫等长循环在内核里可以继续下去，
+// 单劫停一手后立即提回也不受限制；不含劫争的着法序列两者结果相同（见 tests/GameKernelTest.cpp）
+struct GoRules {
+    static constexpr GameType TYPE = GameType::GO;
+
+    struct State {
+        GoChains chains;
+        int koPoint = -1;
+
+        void reset(const Board& board) {
+            chains.rebuild(board);
+            koPoint = -1;
+        }
+    };
+
+    static MoveStatus check(const Board& board, const State& s, int idx, uint8_t me) {
+        if (idx == s.koPoint) return MoveStatus::KO;
+        if (!s.chains.check(board, idx, me).hasLiberty) return MoveStatus::SUICIDE;
+        return MoveStatus::OK;
+    }
+
+    static int apply(Board& board, State& s, int idx, uint8_t me) {
+        return s.chains.place(board, idx, me, s.koPoint, [&board](int p) { board.setAt(p, Board::EMPTY); }).captured;
+    }
+
+    static bool wins(const Board&, int) { return false; }
+
+    // 随机对局不填己方眼（四邻都是己方或边框）
+    static bool playoutCandidate(const Board& board, int idx, uint8_t me) {
+        for (int d : GoChains::DIRS) {
+            uint8_t v = board.at(idx + d);
+            if (v != me && v != Board::BORDER) return true;
+        }
+        return false;
+    }
+};
+
+// 内核的运行期接口
+class IGameKernel {
+public:
+    virtual ~IGameKernel() = default;
+    virtual GameType getType() const = 0;
+    virtual int getSize() const = 0;
+    virtual const Board& getBoard() const = 0;
+    virtual PieceColor getCurrentPlayer() const = 0;
+    virtual bool isOver() const = 0;
+    virtual PieceColor getWinner() const = 0; // 未结束或和棋时为 NONE
+
+    // 回到空棋盘
+    virtual void reset() = 0;
+    virtual MoveStatus tryMove(int x, int y) = 0;
+    // 停一手（五子棋不允许，返回 false）；围棋双方连续停手即数子结束
+    virtual bool passTurn() = 0;
+    // 从当前局面随机对局到终局，返回落子手数；超过 maxMoves 时围棋按双方停手结算，五子棋判和
+    virtual int playRandomGame(uint64_t& rng, int maxMoves) = 0;
+};
+
+// N > 0 为编译期固定尺寸，N == 0 为运行期尺寸的通用版本
+template <int N, class Rules>
+class GameKernel final : public IGameKernel {
+private:
+    Board board;
+    typename Rules::State state;
+    uint8_t side = Board::BLACK;
+    int passes = 0;
+    bool over = false;
+    PieceColor winner = PieceColor::NONE;
+
+    int size() const {
+        if constexpr (N > 0) return N;
+        else return board.getSize();
+    }
+
+    static uint64_t nextRandom(uint64_t& s) {
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        return s;
+    }
+
+    void finish() {
+        over = true;
+        if constexpr (Rules::TYPE == GameType::GO) {
+            GoWinStrategy::AreaScore area = GoWinStrategy::countArea(board);
+            winner = area.black() > area.white() ? PieceColor::BLACK : PieceColor::WHITE;
+        } else {
+            winner = PieceColor::NONE;
+        }
+    }
+
+public:
+    explicit GameKernel(int runtimeSize = N) : board(N > 0 ? N : runtimeSize) { reset(); }
+
+    GameType getType() const override { return Rules::TYPE; }
+    int getSize() const override { return size(); }
+    const Board& getBoard() const override { return board; }
+    PieceColor getCurrentPlayer() const override { return Board::toColor(side); }
+    bool isOver() const override { return over; }
+    PieceColor getWinner() const override { return winner; }
+
+    void reset() override {
+        board = Board(size());
+        state.reset(board);
+        side = Board::BLACK;
+        passes = 0;
+        over = false;
+        winner = PieceColor::NONE;
+    }
+
+    // 按下标落子（非虚函数，内核内部与已知具体类型的调用方直接使用）
+    MoveStatus play(int idx) {
+        if (board.at(idx) != Board::EMPTY) return MoveStatus::OCCUPIED;
+        MoveStatus status = Rules::check(board, state, idx, side);
+        if (status == MoveStatus::OK) place(idx);
+        return status;
+    }
+
+    // 落下已确认合法的一手，返回提子数
+    int place(int idx) {
+        int captured = Rules::apply(board, state, idx, side);
+        if (Rules::wins(board, idx)) {
+            over = true;
+            winner = Board::toColor(side);
+        }
+        side = 3 - side;
+        passes = 0;
+        return captured;
+    }
+
+    MoveStatus tryMove(int x, int y) override {
+        if (x < 0 || x >= size() || y < 0 || y >= size()) return MoveStatus::OUT_OF_RANGE;
+        return play(Board::index(x, y));
+    }
+
+    bool passTurn() override {
+        if constexpr (Rules::TYPE != GameType::GO) {
+            return false;
+        } else {
+            side = 3 - side;
+            state.koPoint = -1;
+            if (++passes >= 2) finish();
+            return true;
+        }
+    }
+
+    // 空点表随落子增量维护，有提子时整体重建
+    int playRandomGame(uint64_t& rng, int maxMoves) override {
+        int empties[Board::CAPACITY];
+        int pos[Board::CAPACITY];
+        int n = 0;
+        auto rebuild = [&]() {
+            n = 0;
+            for (int i = 0; i < size(); ++i) {
+                for (int j = 0; j < size(); ++j) {
+                    int idx = Board::index(i, j);
+                    if (board.at(idx) == Board::EMPTY) {
+                        pos[idx] = n;
+                        empties[n++] = idx;
+                    }
+                }
+            }
+        };
+        rebuild();
+
+        int played = 0;
+        while (!over) {
+            if (played >= maxMoves) {
+                // 五子棋判和；围棋双方停手结算
+                if (passTurn() && !over) passTurn();
+                over = true;
+                break;
+            }
+            int found = -1;
+            if (n > 0) {
+                int start = (int)(nextRandom(rng) % n);
+                for (int k = 0; k < n; ++k) {
+                    int idx = empties[(start + k) % n];
+                    if (Rules::playoutCandidate(board, idx, side) && Rules::check(board, state, idx, side) == MoveStatus::OK) {
+                        found = idx;
+                        break;
+                    }
+                }
+            }
+            played++;
+            if (found < 0) {
+                if (!passTurn()) over = true; // 五子棋下满，和棋
+                continue;
+            }
+            if (place(found) > 0) {
+                rebuild();
+            } else {
+                int last = empties[--n];
+                empties[pos[found]] = last;
+                pos[last] = pos[found];
+            }
+        }
+        return played;
+    }
+};
+
+#endif // GAMEKERNEL_H
@@ -1,34 +1,108 @@
 #ifndef GAMEMEMENTO_H
 #define GAMEMEMENTO_H
 
-#include <vector>
 #include <string>
+#include <vector>
 #include <sstream>
 #include <memory>
+#include <utility>
 #include <iostream>
+#include <cstdint>
+#include <cstddef>
 #include "GameTypes.h"
+#include "Board.h"
+
+class AbstractGame; // 前置声明
+
+// 存档头各字段的取值范围，文本存档、二进制存档与重放校验共用
+// 连续两次停手即终局，停手计数只会是 0 或 1；轮到的一方须为黑或白
+inline bool isValidMementoHeader(int size, int pass, PieceColor player) {
+    return size >= 1 && size <= Board::MAX_SIZE && pass >= 0 && pass <= 1 && player != PieceColor::NONE;
+}
+
+// 二进制存档记录（版本 1），多条记录可首尾相接存放在同一文件中：
+//   [0..2] 魔数 "GMB"  [3] 版本  [4] 类型 0五子棋/1围棋  [5] 尺寸  [6] 当前玩家  [7] 停手计数
+//   [8..9] 着法数（小端）  随后为棋盘，每格 2 位按行优先打包  最后为着法表，每步 2 字节（x*size+y，停一手为 0xFFFF）
+// 只读视图：字段直接指向输入缓冲区，解析不拷贝棋盘与着法
+struct GameRecordView {
+    static constexpr uint8_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 10;
+    static constexpr uint16_t PASS_MOVE = 0xFFFF;
+
+    GameType type;
+    int boardSize;
+    PieceColor currentPlayer;
+    int passCount;
+    int moveCount;
+    const uint8_t* cells;
+    const uint8_t* moves;
+
+    static size_t cellBytes(int size) { return (size_t)(size * size + 3) / 4; }
 
-class AbstractGame; // ǰ
+    uint8_t cell(int x, int y) const {
+        int i = x * boardSize + y;
+        return (cells[i >> 2] >> ((i & 3) * 2)) & 3;
+    }
+
+    // 第 k 步：返回 x*size+y，停一手返回 -1
+    int moveAt(int k) const {
+        uint16_t m = (uint16_t)(moves[2 * k] | (moves[2 * k + 1] << 8));
+        return m == PASS_MOVE ? -1 : m;
+    }
+
+    // 判断缓冲区开头是否为二进制存档
+    static bool isBinary(const uint8_t* data, size_t len) {
+        return len >= 4 && data[0] == 'G' && data[1] == 'M' && data[2] == 'B';
+    }
 
-// ¼洢Ϸ
+    // 从 data 解析一条记录，成功时返回其占用的字节数
+    static size_t parse(const uint8_t* data, size_t len, GameRecordView& out) {
+        if (len < HEADER_SIZE || !isBinary(data, len)) throw GameException("存档格式错误");
+        if (data[3] != VERSION) throw GameException("不支持的存档版本");
+        if (data[4] > 1 || !isValidMementoHeader(data[5], data[7], Board::toColor(data[6]))) throw GameException("存档格式错误");
+
+        out.type = data[4] == 0 ? GameType::GOMOKU : GameType::GO;
+        out.boardSize = data[5];
+        out.currentPlayer = Board::toColor(data[6]);
+        out.passCount = data[7];
+        out.moveCount = data[8] | (data[9] << 8);
+
+        size_t total = HEADER_SIZE + cellBytes(out.boardSize) + 2 * (size_t)out.moveCount;
+        if (len < total) throw GameException("存档数据不完整");
+        out.cells = data + HEADER_SIZE;
+        out.moves = out.cells + cellBytes(out.boardSize);
+
+        // 着法须落在棋盘内（停一手除外），读出的记录可以直接交给 x / size、x % size 使用
+        int cellCount = out.boardSize * out.boardSize;
+        for (int k = 0; k < out.moveCount; ++k) {
+            int m = out.moveAt(k);
+            if (m >= cellCount) throw GameException("存档格式错误");
+        }
+        return total;
+    }
+};
+
+// 备忘录：存储游戏快照
 class GameMemento {
-    friend class AbstractGame; //  Game ڲ
+    friend class AbstractGame; // 允许 Game 访问内部数据
 private:
-    std::vector<std::vector<int>> boardData; // 0:None, 1:Black, 2:White
+    Board boardData; // 0:None, 1:Black, 2:White
     PieceColor currentPlayer;
     int boardSize;
     GameType type;
-    int passCount; // Χּͣ
+    int passCount; // 围棋停手计数
+    std::vector<int> moves; // 可选的着法记录：x*size+y，停一手为 -1
 
 public:
-    GameMemento(const std::vector<std::vector<int>>& data, PieceColor p, int size, GameType t, int pass)
-        : boardData(data), currentPlayer(p), boardSize(size), type(t), passCount(pass) {}
+    GameMemento(const Board& data, PieceColor p, int size, GameType t, int pass, std::vector<int> mv = {})
+        : boardData(data), currentPlayer(p), boardSize(size), type(t), passCount(pass), moves(std::move(mv)) {}
 
     GameType getGameType() const { return type; }
     int getBoardSize() const { return boardSize; }
     PieceColor getCurrentPlayer() const { return currentPlayer; }
+    const std::vector<int>& getMoves() const { return moves; }
 
-    // лΪַڴ浵
+    // 序列化为字符串（用于存档）
     std::string serialize() const {
         std::stringstream ss;
         ss << (type == GameType::GOMOKU ? "GOMOKU" : "GO") << " "
@@ -36,14 +110,14 @@ public:
            << colorToString(currentPlayer) << "\n";
         for (int i = 0; i < boardSize; ++i) {
             for (int j = 0; j < boardSize; ++j) {
-                ss << boardData[i][j] << " ";
+                ss << (int)boardData.get(i, j) << " ";
             }
             ss << "\n";
         }
         return ss.str();
     }
 
-    // ַлڶ
+    // 从字符串反序列化（用于读档）
     static std::shared_ptr<GameMemento> deserialize(std::istream& is) {
         std::string typeStr, playerStr;
         int size, pass;
@@ -52,14 +126,74 @@ public:
         GameType t = (typeStr == "GOMOKU") ? GameType::GOMOKU : GameType::GO;
         PieceColor p = stringToColor(playerStr);
 
-        std::vector<std::vector<int>> data(size, std::vector<int>(size));
+        if (!is || !isValidMementoHeader(size, pass, p)) throw GameException("存档格式错误");
+
+        Board data(size);
         for (int i = 0; i < size; ++i) {
             for (int j = 0; j < size; ++j) {
-                is >> data[i][j];
+                int v;
+                is >> v;
+                if (!is || v < 0 || v > 2) throw GameException("存档格式错误");
+                data.set(i, j, (uint8_t)v);
             }
         }
         return std::make_shared<GameMemento>(data, p, size, t, pass);
     }
+
+    // 序列化为二进制记录（格式见 GameRecordView）
+    std::string serializeBinary() const {
+        if (moves.size() > 0xFFFE) throw GameException("着法过多，无法写入二进制存档");
+        size_t cellBytes = GameRecordView::cellBytes(boardSize);
+        std::string out(GameRecordView::HEADER_SIZE + cellBytes + 2 * moves.size(), '\0');
+        uint8_t* p = reinterpret_cast<uint8_t*>(&out[0]);
+
+        p[0] = 'G'; p[1] = 'M'; p[2] = 'B';
+        p[3] = GameRecordView::VERSION;
+        p[4] = (type == GameType::GOMOKU) ? 0 : 1;
+        p[5] = (uint8_t)boardSize;
+        p[6] = Board::fromColor(currentPlayer);
+        p[7] = (uint8_t)passCount;
+        p[8] = (uint8_t)(moves.size() & 0xFF);
+        p[9] = (uint8_t)(moves.size() >> 8);
+
+        uint8_t* cells = p + GameRecordView::HEADER_SIZE;
+        for (int i = 0; i < boardSize; ++i) {
+            for (int j = 0; j < boardSize; ++j) {
+                int k = i * boardSize + j;
+                cells[k >> 2] |= (uint8_t)(boardData.get(i, j) << ((k & 3) * 2));
+            }
+        }
+
+        uint8_t* mv = cells + cellBytes;
+        for (size_t k = 0; k < moves.size(); ++k) {
+            uint16_t m = moves[k] < 0 ? GameRecordView::PASS_MOVE : (uint16_t)moves[k];
+            mv[2 * k] = (uint8_t)(m & 0xFF);
+            mv[2 * k + 1] = (uint8_t)(m >> 8);
+        }
+        return out;
+    }
+
+    // 从二进制记录视图构造备忘录
+    static std::shared_ptr<GameMemento> fromRecord(const GameRecordView& rec) {
+        Board data(rec.boardSize);
+        for (int i = 0; i < rec.boardSize; ++i) {
+            for (int j = 0; j < rec.boardSize; ++j) {
+                uint8_t v = rec.cell(i, j);
+                if (v > 2) throw GameException("存档格式错误");
+                data.set(i, j, v);
+            }
+        }
+        std::vector<int> mv(rec.moveCount);
+        for (int k = 0; k < rec.moveCount; ++k) mv[k] = rec.moveAt(k);
+        return std::make_shared<GameMemento>(data, rec.currentPlayer, rec.boardSize, rec.type, rec.passCount, std::move(mv));
+    }
+
+    // 从二进制缓冲区反序列化一条记录
+    static std::shared_ptr<GameMemento> deserializeBinary(const uint8_t* data, size_t len) {
+        GameRecordView rec;
+        GameRecordView::parse(data, len, rec);
+        return fromRecord(rec);
+    }
 };
 
 #endif // GAMEMEMENTO_H
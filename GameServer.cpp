@@ -0,0 +1,445 @@
+#include "GameServer.h"
+#include "GameSession.h"
+#include "UIBuilder.h"
+#include "OpeningBook.h"
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+void notifyFd(int fd) {
+    uint64_t one = 1;
+    ssize_t n = ::write(fd, &one, sizeof(one));
+    (void)n;
+}
+
+void drainFd(int fd) {
+    uint64_t v;
+    ssize_t n = ::read(fd, &v, sizeof(v));
+    (void)n;
+}
+
+} // namespace
+
+// 一个客户端连接：收发缓冲与独立的会话
+struct Connection {
+    int fd;
+    std::string in;
+    std::string out;   // 渲染结果直接追加到这里
+    size_t outPos = 0; // out 中已发送的字节数
+    bool closing = false;
+    bool inputClosed = false; // 对端已关闭写方向，缓冲中的指令执行完即关闭
+    bool wantWrite = false;   // 是否在等待 EPOLLOUT
+    uint32_t events = 0;      // 当前登记在 epoll 上的事件
+    std::shared_ptr<ConsoleUI> ui;
+    std::unique_ptr<GameSession> session;
+};
+
+// genmove 的搜索线程池：每个线程一套引擎，节点池与置换表只按线程数分配，不随会话数增长
+// 任务按提交顺序排队；一个连接同一时刻最多一个任务，队列长度不超过连接数
+struct GameServer::SearchPool {
+    using Job = std::function<void(SearchEngines&)>;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<Job> jobs;
+    bool stopping = false;
+    std::vector<std::thread> threads;
+
+    explicit SearchPool(int n) {
+        for (int i = 0; i < n; ++i) threads.emplace_back([this]() { loop(); });
+    }
+
+    // 丢弃还在排队的任务，等进行中的搜索结束（搜索时间有上限）
+    ~SearchPool() {
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            stopping = true;
+            jobs.clear();
+        }
+        ready.notify_all();
+        for (auto& t : threads) t.join();
+    }
+
+    void submit(Job job) {
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            jobs.push_back(std::move(job));
+        }
+        ready.notify_one();
+    }
+
+    void loop() {
+        SearchEngines engines;
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lk(mutex);
+                ready.wait(lk, [this]() { return stopping || !jobs.empty(); });
+                if (stopping) return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            job(engines);
+        }
+    }
+};
+
+// 工作线程：独占一个 epoll 实例和分给它的连接
+struct GameServer::Worker {
+    GameServer& server;
+    int epfd = -1;
+    int wakeFd = -1; // 有新连接或要停止时写入
+    std::thread thread;
+
+    std::mutex incomingMutex;
+    std::vector<int> incoming; // 主线程交过来、尚未登记的连接
+    std::vector<std::pair<Connection*, SearchOutcome>> finished; // 搜索线程交回的结果（同一把锁）
+    std::atomic<bool> stopping{false};
+
+    std::unordered_map<int, std::unique_ptr<Connection>> conns;
+    // 搜索进行中被关闭的连接：搜索线程还在读它的对局，结果交回后再销毁
+    std::unordered_map<Connection*, std::unique_ptr<Connection>> orphans;
+
+    explicit Worker(GameServer& s) : server(s) {
+        epfd = epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epfd < 0 || wakeFd < 0) throw GameException("服务器初始化失败");
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;
+        epoll_ctl(epfd, EPOLL_CTL_ADD, wakeFd, &ev);
+    }
+
+    ~Worker() {
+        for (auto& kv : conns) ::close(kv.first);
+        if (epfd >= 0) ::close(epfd);
+        if (wakeFd >= 0) ::close(wakeFd);
+    }
+
+    void loop() {
+        epoll_event events[256];
+        while (true) {
+            int n = epoll_wait(epfd, events, 256, -1);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return;
+            }
+            bool woken = false;
+            for (int i = 0; i < n; ++i) {
+                Connection* c = static_cast<Connection*>(events[i].data.ptr);
+                if (!c) {
+                    woken = true;
+                    continue;
+                }
+                uint32_t e = events[i].events;
+                if (e & (EPOLLERR | EPOLLHUP)) {
+                    closeConnection(c);
+                    continue;
+                }
+                if ((e & EPOLLIN) && !readInput(c)) continue;
+                if (e & EPOLLOUT) flushOutput(c);
+            }
+            // 交回的搜索结果可能关闭其他连接，放在本批事件之后处理，免得后面的事件指向已销毁的连接
+            if (woken) {
+                drainFd(wakeFd);
+                if (stopping.load()) return;
+                acceptIncoming();
+                finishSearches();
+            }
+        }
+    }
+
+    void acceptIncoming() {
+        std::vector<int> fds;
+        {
+            std::lock_guard<std::mutex> lk(incomingMutex);
+            fds.swap(incoming);
+        }
+        for (int fd : fds) {
+            auto conn = std::make_unique<Connection>();
+            Connection* c = conn.get();
+            c->fd = fd;
+            c->ui = StandardUIBuilder().build();
+            c->ui->setOutput(&c->out);
+            c->session = std::make_unique<GameSession>(c->ui, server.config.allowFiles);
+            c->session->setOpeningBook(server.book);
+            c->session->setSearchLimits(server.config.maxSearchMs, server.config.maxSearchThreads);
+            c->session->setSearchRunner([this, c](SearchTask task) {
+                server.searchPool->submit([this, c, task = std::move(task)](SearchEngines& engines) mutable {
+                    SearchOutcome outcome;
+                    try {
+                        outcome = task(engines);
+                    } catch (const std::exception& e) {
+                        outcome.error = e.what();
+                    }
+                    // 任务持有对局的引用（分配在会话的内存区里），须在交回结果之前释放：交回后会话随时可能销毁
+                    task = nullptr;
+                    {
+                        std::lock_guard<std::mutex> lk(incomingMutex);
+                        finished.push_back({c, std::move(outcome)});
+                    }
+                    notifyFd(wakeFd);
+                });
+            });
+
+            epoll_event ev{};
+            ev.events = c->events = EPOLLIN | EPOLLRDHUP;
+            ev.data.ptr = c;
+            if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+                ::close(fd);
+                continue;
+            }
+            conns[fd] = std::move(conn);
+            server.sessions++;
+
+            c->ui->render();
+            flushOutput(c);
+        }
+    }
+
+    // 搜索结果交回：落子并继续执行搜索期间积压的指令
+    void finishSearches() {
+        std::vector<std::pair<Connection*, SearchOutcome>> results;
+        {
+            std::lock_guard<std::mutex> lk(incomingMutex);
+            results.swap(finished);
+        }
+        for (auto& r : results) {
+            Connection* c = r.first;
+            if (orphans.erase(c)) continue;
+            c->session->finishSearch(r.second);
+            c->ui->render();
+            processLines(c);
+        }
+    }
+
+    // 读入并逐行执行指令；连接被关闭时返回 false
+    bool readInput(Connection* c) {
+        char buf[4096];
+        bool eof = false;
+        while (true) {
+            ssize_t n = ::recv(c->fd, buf, sizeof(buf), 0);
+            if (n > 0) {
+                c->in.append(buf, n);
+                continue;
+            }
+            if (n == 0) eof = true;
+            else if (errno == EINTR) continue;
+            else if (errno != EAGAIN && errno != EWOULDBLOCK) eof = true;
+            break;
+        }
+        if (eof) {
+            // 对端关闭写方向：不再关注可读，把已收到的指令执行完、输出发完再关闭
+            c->inputClosed = true;
+            updateEvents(c);
+        }
+        return processLines(c);
+    }
+
+    // 逐行执行缓冲中的指令，搜索进行中暂停，等结果交回再继续；连接被关闭时返回 false
+    bool processLines(Connection* c) {
+        size_t start = 0;
+        while (!c->closing && !c->session->isSearching()) {
+            size_t nl = c->in.find('\n', start);
+            if (nl == std::string::npos) break;
+            size_t end = nl;
+            if (end > start && c->in[end - 1] == '\r') --end;
+            std::string_view line(c->in.data() + start, end - start);
+            start = nl + 1;
+            if (line.empty()) continue;
+
+            if (!c->session->processCommand(line)) {
+                c->closing = true;
+                break;
+            }
+            c->ui->render();
+        }
+        c->in.erase(0, start);
+        size_t lastLine = c->in.rfind('\n');
+        size_t partial = c->in.size() - (lastLine == std::string::npos ? 0 : lastLine + 1);
+        if (partial > server.config.maxLineLength || c->in.size() > server.config.maxPendingInput) {
+            c->out += "\r\n指令过长，连接已断开\r\n";
+            c->closing = true;
+        }
+
+        if (c->inputClosed && !c->session->isSearching()) c->closing = true;
+        return flushOutput(c);
+    }
+
+    // 尽量写出发送缓冲；写不完时等待 EPOLLOUT。连接被关闭时返回 false
+    bool flushOutput(Connection* c) {
+        while (c->outPos < c->out.size()) {
+            ssize_t n = ::send(c->fd, c->out.data() + c->outPos, c->out.size() - c->outPos, MSG_NOSIGNAL);
+            if (n > 0) {
+                c->outPos += (size_t)n;
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                if (c->out.size() - c->outPos > server.config.maxPendingOutput) {
+                    closeConnection(c);
+                    return false;
+                }
+                setWantWrite(c, true);
+                return true;
+            }
+            closeConnection(c);
+            return false;
+        }
+        c->out.clear();
+        c->outPos = 0;
+        setWantWrite(c, false);
+        if (c->closing) {
+            closeConnection(c);
+            return false;
+        }
+        return true;
+    }
+
+    void setWantWrite(Connection* c, bool want) {
+        if (c->wantWrite == want) return;
+        c->wantWrite = want;
+        updateEvents(c);
+    }
+
+    void updateEvents(Connection* c) {
+        uint32_t events = (c->inputClosed ? 0u : (uint32_t)(EPOLLIN | EPOLLRDHUP)) | (c->wantWrite ? (uint32_t)EPOLLOUT : 0u);
+        if (c->events == events) return;
+        c->events = events;
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.ptr = c;
+        epoll_ctl(epfd, EPOLL_CTL_MOD, c->fd, &ev);
+    }
+
+    void closeConnection(Connection* c) {
+        int fd = c->fd;
+        epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);
+        ::close(fd);
+        auto it = conns.find(fd);
+        if (c->session->isSearching()) orphans[c] = std::move(it->second);
+        conns.erase(it);
+        server.sessions--;
+    }
+};
+
+GameServer::GameServer(const ServerConfig& cfg) : config(cfg) {
+    if (config.threads <= 0) config.threads = (int)std::thread::hardware_concurrency();
+    if (config.threads <= 0) config.threads = 1;
+    if (config.searchThreads <= 0) config.searchThreads = (int)std::thread::hardware_concurrency();
+    if (config.searchThreads <= 0) config.searchThreads = 1;
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (stopFd < 0) throw GameException("服务器初始化失败");
+    if (!config.bookPath.empty()) book = std::make_shared<const OpeningBook>(config.bookPath);
+}
+
+GameServer::~GameServer() {
+    if (listenFd >= 0) ::close(listenFd);
+    if (stopFd >= 0) ::close(stopFd);
+    if (!config.unixPath.empty()) ::unlink(config.unixPath.c_str());
+}
+
+void GameServer::openListener() {
+    if (!config.unixPath.empty()) {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (config.unixPath.size() >= sizeof(addr.sun_path)) throw GameException("套接字路径过长");
+        std::strcpy(addr.sun_path, config.unixPath.c_str());
+        ::unlink(config.unixPath.c_str());
+
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0 || bind(listenFd, (sockaddr*)&addr, sizeof(addr)) < 0) throw GameException("无法监听 " + config.unixPath);
+    } else {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)config.port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int on = 1;
+        if (listenFd >= 0) setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if (listenFd < 0 || bind(listenFd, (sockaddr*)&addr, sizeof(addr)) < 0) throw GameException("无法监听端口 " + std::to_string(config.port));
+    }
+    if (listen(listenFd, SOMAXCONN) < 0) throw GameException("无法监听");
+}
+
+// 新连接轮流分给各工作线程
+void GameServer::dispatch(int fd) {
+    Worker& w = *workers[nextWorker++ % workers.size()];
+    {
+        std::lock_guard<std::mutex> lk(w.incomingMutex);
+        w.incoming.push_back(fd);
+    }
+    notifyFd(w.wakeFd);
+}
+
+void GameServer::run() {
+    openListener();
+    searchPool = std::make_unique<SearchPool>(config.searchThreads);
+    for (int i = 0; i < config.threads; ++i) {
+        workers.push_back(std::make_unique<Worker>(*this));
+    }
+    for (auto& w : workers) {
+        Worker* p = w.get();
+        p->thread = std::thread([p]() { p->loop(); });
+    }
+
+    int epfd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, listenFd, &ev);
+    ev.data.fd = stopFd;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, stopFd, &ev);
+
+    bool stopped = false;
+    while (!stopped) {
+        epoll_event events[2];
+        int n = epoll_wait(epfd, events, 2, -1);
+        if (n < 0 && errno != EINTR) break;
+        for (int i = 0; i < n; ++i) {
+            if (events[i].data.fd == stopFd) {
+                stopped = true;
+                continue;
+            }
+            while (true) {
+                int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0) break; // EAGAIN 或暂时性错误（如 EMFILE），下次再试
+                if (config.unixPath.empty()) {
+                    int on = 1;
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+                }
+                dispatch(fd);
+            }
+        }
+    }
+    ::close(epfd);
+
+    for (auto& w : workers) {
+        w->stopping.store(true);
+        notifyFd(w->wakeFd);
+    }
+    for (auto& w : workers) w->thread.join();
+    // 先等搜索线程停下（进行中的搜索还在读连接上的对局），再销毁连接
+    searchPool.reset();
+    workers.clear();
+}
+
+void GameServer::stop() {
+    notifyFd(stopFd);
+}
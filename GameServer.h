@@ -0,0 +1,62 @@
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+class OpeningBook;
+
+// 服务器配置
+struct ServerConfig {
+    std::string unixPath;     // 非空时监听 Unix 域套接字
+    int port = 0;             // 否则监听 127.0.0.1 上的 TCP 端口
+    int threads = 0;          // 工作线程数，0 表示按 CPU 核数
+    bool allowFiles = false;  // 是否允许客户端使用 save/load 等读写本机文件的指令
+    std::string bookPath;     // 非空时启动时载入开局库，所有会话共用
+    size_t maxLineLength = 4096; // 单行指令上限，超出则断开连接
+    size_t maxPendingInput = 1 << 16;  // 搜索进行中积压的指令上限，超出则断开连接
+    size_t maxPendingOutput = 1 << 20; // 客户端不读取时积压的输出上限，超出则断开连接
+    int searchThreads = 1;    // genmove 搜索线程数（每个线程一套引擎），0 表示按 CPU 核数
+    int maxSearchMs = 1000;   // 单次 genmove 的思考时间上限，0 表示不限
+    int maxSearchThreads = 1; // 单次 genmove 的搜索线程数上限（围棋 MCTS 可多线程），0 表示不限
+};
+
+// 多会话对局服务器（仅 Linux，基于 epoll）
+// 主线程负责 accept，把新连接轮流分给各工作线程；每个工作线程用自己的 epoll 管理一批连接，
+// 连接上的读、指令处理、写都在同一个线程里完成，会话之间只共享只读的开局库，不需要加锁
+// 每个连接拥有独立的 GameSession（对局 + 界面），指令语法与控制台完全相同，界面以 ANSI 差分输出
+// genmove 的搜索不占工作线程：交给搜索线程池排队执行（引擎按搜索线程分配，各会话共用），
+// 期间该连接暂停处理后续指令，结果交回工作线程后再落子、继续处理
+class GameServer {
+public:
+    struct Worker;
+    struct SearchPool;
+
+private:
+    ServerConfig config;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::unique_ptr<SearchPool> searchPool;
+    int listenFd = -1;
+    int stopFd = -1; // eventfd：stop() 写入后 run() 返回
+    size_t nextWorker = 0;
+    std::atomic<long> sessions{0};
+    std::shared_ptr<const OpeningBook> book;
+
+    void openListener();
+    void dispatch(int fd);
+
+public:
+    explicit GameServer(const ServerConfig& cfg);
+    ~GameServer();
+
+    // 阻塞运行，直到 stop() 被调用
+    void run();
+    // 可从其他线程或信号处理函数中调用
+    void stop();
+
+    long getSessionCount() const { return sessions.load(); }
+};
+
+#endif // GAMESERVER_H
@@ -0,0 +1,348 @@
+#include "GameSession.h"
+#include "GameFactory.h"
+#include "GameArchive.h"
+#include "Sgf.h"
+#include "CommandParser.h"
+#include "Metrics.h"
+#include <sstream>
+#include <fstream>
+
+namespace {
+
+// 用 engines 搜索 game 当前局面；timeMs 须为正数，threads 为 0 表示使用全部硬件线程
+SearchOutcome runSearch(const AbstractGame& game, SearchEngines& engines, int timeMs, int threads) {
+    SearchOutcome out;
+    std::stringstream info;
+    if (game.getType() == GameType::GO) {
+        MctsLimits limits;
+        limits.timeMs = timeMs;
+        limits.threads = threads;
+
+        if (!engines.go) engines.go = std::make_unique<GoMcts>();
+        MctsResult res = engines.go->search(static_cast<const GoGame&>(game), limits);
+        out.found = true;
+        out.pass = res.pass;
+        out.x = res.x;
+        out.y = res.y;
+        info << " (胜率 " << (int)(res.winRate * 100) << "%, 模拟 " << res.playouts << " 局, "
+             << res.threads << " 线程, " << (long)res.playoutsPerSec << " 局/秒)";
+    } else {
+        SearchLimits limits;
+        limits.timeMs = timeMs;
+
+        if (!engines.gomoku) engines.gomoku = std::make_unique<GomokuEngine>();
+        SearchResult res = engines.gomoku->search(game, limits);
+        out.found = res.x >= 0;
+        out.x = res.x;
+        out.y = res.y;
+        info << " (深度 " << res.depth << ", 节点 " << res.nodes << ", 用时 " << (int)res.elapsedMs << "ms)";
+    }
+    out.info = info.str();
+    return out;
+}
+
+} // namespace
+
+GameSession::GameSession(std::shared_ptr<ConsoleUI> view, bool files) : ui(view), allowFiles(files), running(true) {}
+
+void GameSession::discardGame() {
+    game = nullptr;
+    pool.release();
+    arena.reset();
+}
+
+void GameSession::reportError(const char* error) {
+    METRIC_COUNT(Counter::COMMAND_ERROR);
+    ui->onMessage(std::string("错误: ") + error);
+}
+
+// 命令处理：预期内的用户错误（未开局、参数不对、不可落子）以返回值报告，
+// 只有读写文件、解析存档等少见的失败才走异常
+bool GameSession::processCommand(std::string_view line) {
+    METRIC_SCOPE(Metric::COMMAND);
+    Command cmd = parseCommand(line);
+    try {
+        const char* error = execute(cmd);
+        if (error) reportError(error);
+    } catch (const std::exception& e) {
+        // 异常处理：在UI层显示错误
+        reportError(e.what());
+    }
+    return running;
+}
+
+// 搜索执行器交回结果：局面在搜索期间没有变动，直接落子
+void GameSession::finishSearch(const SearchOutcome& outcome) {
+    searching = false;
+    try {
+        const char* error = applySearch(outcome);
+        if (error) reportError(error);
+    } catch (const std::exception& e) {
+        reportError(e.what());
+    }
+}
+
+const char* GameSession::applySearch(const SearchOutcome& outcome) {
+    if (!outcome.error.empty()) throw GameException(outcome.error);
+    if (!game) return "游戏未开始";
+    if (!outcome.found) return "没有可以落子的位置";
+    MoveStatus status = outcome.pass ? game->tryPass() : game->tryMove(outcome.x, outcome.y);
+    if (status != MoveStatus::OK) return moveStatusText(status);
+
+    std::stringstream info;
+    if (outcome.pass) info << "电脑停一手";
+    else info << "电脑落子: " << outcome.x + 1 << " " << outcome.y + 1;
+    info << outcome.info;
+    ui->onMessage(info.str());
+    return nullptr;
+}
+
+// 按指令编号分发，成功返回 nullptr，否则返回错误信息
+const char* GameSession::execute(const Command& cmd) {
+    switch (cmd.id) {
+    case CommandId::EMPTY:
+        return nullptr;
+    case CommandId::EXIT:
+        running = false;
+        return nullptr;
+    case CommandId::HELP: {
+        std::string help = "指令列表:\n"
+                           "  start gomoku|go [8-19] : 开始新游戏\n"
+                           "  move x y : 落子 (行 列，从1开始)\n"
+                           "  pass : 停一手 (仅围棋)\n"
+                           "  undo : 悔棋\n"
+                           "  resign : 认输\n"
+                           "  save filename : 保存 (.gmb 后缀保存为二进制格式)\n"
+                           "  load filename : 读取\n"
+                           "  sgfsave filename : 导出 SGF 棋谱\n"
+                           "  sgfload filename [n] : 导入 SGF 棋谱 (集合中的第 n 局，默认 1)\n"
+                           "  genmove [ms] [threads] : 电脑落子 (五子棋默认思考 100 毫秒，围棋默认 1000 毫秒)\n"
+                           "  hint : 开关提示\n"
+                           "  book [load filename] : 查询当前局面的开局库着法 (或载入开局库)\n"
+                           "  stats [reset] : 查看 (或清零) 性能统计\n"
+                           "  exit : 退出";
+        ui->onMessage(help);
+        return nullptr;
+    }
+    case CommandId::START: {
+        std::string_view typeStr = cmd.arg(0);
+        int size = 0;
+        cmd.intArg(1, size);
+        if (size < 8 || size > 19) return "尺寸必须在 8 到 19 之间";
+
+        // 根据输入选择对应的工厂
+        std::shared_ptr<IGameFactory> factory;
+        if (typeStr == "go") {
+            factory = std::make_shared<GoFactory>();
+        } else if (typeStr == "gomoku") {
+            factory = std::make_shared<GomokuFactory>();
+        } else {
+            return "未知的游戏类型，请输入 go 或 gomoku";
+        }
+
+        // 使用工厂创建产品：先销毁旧对局，再收回内存区给新对局使用
+        discardGame();
+        game = factory->createGame(size, &pool);
+        ui->updateGameStatus(getGameName(game->getType()));
+        
+        game->addObserver(ui);
+        game->refresh();
+        return nullptr;
+    }
+    case CommandId::MOVE: {
+        if (!game) return "游戏未开始";
+        int r = 0, c = 0;
+        cmd.intArg(0, r);
+        cmd.intArg(1, c);
+        MoveStatus status = game->tryMove(r - 1, c - 1); // 用户输入1-based，内部0-based
+        return status == MoveStatus::OK ? nullptr : moveStatusText(status);
+    }
+    case CommandId::PASS: {
+        if (!game) return "游戏未开始";
+        MoveStatus status = game->tryPass();
+        return status == MoveStatus::OK ? nullptr : moveStatusText(status);
+    }
+    case CommandId::UNDO:
+        if (!game) return "游戏未开始";
+        if (game->getHistory().empty()) return "没有可以悔棋的记录";
+        game->undo();
+        return nullptr;
+    case CommandId::RESIGN:
+        if (!game) return "游戏未开始";
+        game->resign();
+        game = nullptr; // 结束引用
+        return nullptr;
+    case CommandId::SAVE: {
+        if (!allowFiles) return "当前会话不允许读写文件";
+        if (!game) return "游戏未开始";
+        std::string file(cmd.arg(0));
+        bool binary = file.size() > 4 && file.compare(file.size() - 4, 4, ".gmb") == 0;
+        std::ofstream ofs(file, binary ? std::ios::binary : std::ios::out);
+        if (!ofs) return "文件创建失败";
+        if (binary) {
+            std::string bytes = game->createMemento()->serializeBinary();
+            ofs.write(bytes.data(), bytes.size());
+        } else {
+            ofs << game->createMemento()->serialize();
+        }
+        ui->onMessage("游戏已保存至 " + file);
+        return nullptr;
+    }
+    case CommandId::LOAD: {
+        if (!allowFiles) return "当前会话不允许读写文件";
+        std::string file(cmd.arg(0));
+        std::ifstream ifs(file, std::ios::binary);
+        if (!ifs) return "文件读取失败";
+
+        // 按文件头判断格式：二进制存档读取其中第一条记录，否则按文本格式解析
+        char magic[4] = {0};
+        ifs.read(magic, sizeof(magic));
+        bool binary = GameRecordView::isBinary(reinterpret_cast<const uint8_t*>(magic), (size_t)ifs.gcount());
+        ifs.clear();
+        ifs.seekg(0);
+
+        // 反序列化备忘录
+        std::shared_ptr<GameMemento> mem;
+        if (binary) {
+            GameArchive archive(file);
+            GameRecordView rec;
+            if (!archive.next(rec)) return "存档为空";
+            mem = GameMemento::fromRecord(rec);
+        } else {
+            mem = GameMemento::deserialize(ifs);
+        }
+        
+        // 根据存档记录的游戏类型选择工厂
+        std::shared_ptr<IGameFactory> factory;
+        if (mem->getGameType() == GameType::GO) {
+            factory = std::make_shared<GoFactory>();
+        } else {
+            factory = std::make_shared<GomokuFactory>();
+        }
+
+        // 重建游戏并恢复状态
+        discardGame();
+        game = factory->createGame(mem->getBoardSize(), &pool);
+        game->restoreMemento(mem);
+        
+        ui->updateGameStatus(getGameName(game->getType()));
+        game->addObserver(ui);
+        game->refresh();
+        ui->onMessage("游戏已读取: " + file);
+        return nullptr;
+    }
+    case CommandId::SGFSAVE: {
+        if (!allowFiles) return "当前会话不允许读写文件";
+        if (!game) return "游戏未开始";
+        std::string file(cmd.arg(0));
+        std::ofstream ofs(file, std::ios::binary);
+        if (!ofs) return "文件创建失败";
+        ofs << SgfWriter::write(*game);
+        ui->onMessage("棋谱已导出至 " + file);
+        return nullptr;
+    }
+    case CommandId::SGFLOAD: {
+        if (!allowFiles) return "当前会话不允许读写文件";
+        std::string file(cmd.arg(0));
+        int n = 1;
+        cmd.intArg(1, n);
+        if (n < 1) return "对局序号必须从 1 开始";
+
+        // 流式读取棋谱集合，跳过前 n-1 局
+        SgfReader reader(file);
+        for (int i = 1; i < n; ++i) {
+            if (!reader.skipGame()) throw GameException("棋谱中没有第 " + std::to_string(n) + " 局");
+        }
+        auto loaded = reader.nextGame();
+        if (!loaded) throw GameException("棋谱中没有第 " + std::to_string(n) + " 局");
+
+        // 读入的对局在全局堆上，旧对局的内存区同样收回
+        discardGame();
+        game = loaded;
+        ui->updateGameStatus(getGameName(game->getType()));
+        game->addObserver(ui);
+        game->refresh();
+        ui->onMessage("棋谱已导入: " + file);
+        return nullptr;
+    }
+    case CommandId::STATS:
+        if (cmd.arg(0) == "reset") {
+            Metrics::reset();
+            ui->onMessage("性能统计已清零");
+        } else {
+            ui->onMessage(Metrics::report());
+        }
+        return nullptr;
+    case CommandId::GENMOVE: {
+        if (!game) return "游戏未开始";
+        if (game->isOver()) return "游戏已结束";
+        int ms = 0;
+        bool hasTime = cmd.intArg(0, ms);
+        // 两种引擎对 0 的处理不同（五子棋不限时一直搜到最大深度，围棋不搜索），交互时都不接受
+        if (hasTime && ms <= 0) return "思考时间必须为正数 (毫秒)";
+        std::stringstream info;
+
+        // 先查开局库：命中且合法时直接落子，不再搜索（库不区分劫争，不合法时照常搜索）
+        OpeningBook::BookMove bm;
+        if (book && book->probe(*game, bm)) {
+            bool played = false;
+            if (bm.pass) {
+                played = game->tryPass() == MoveStatus::OK;
+            } else {
+                played = game->tryMove(bm.x, bm.y) == MoveStatus::OK;
+            }
+            if (played) {
+                if (bm.pass) info << "电脑停一手";
+                else info << "电脑落子: " << bm.x + 1 << " " << bm.y + 1;
+                info << " (开局库, 对局 " << bm.games << " 局, 胜率 " << (int)(bm.winRate * 100) << "%)";
+                ui->onMessage(info.str());
+                return nullptr;
+            }
+        }
+
+        // 未指定时按各棋类的默认思考时间；设了上限时，不限时（0）或超过上限的要求都按上限
+        int timeMs = hasTime ? ms : (game->getType() == GameType::GO ? MctsLimits().timeMs : SearchLimits().timeMs);
+        if (maxSearchMs > 0 && (timeMs <= 0 || timeMs > maxSearchMs)) timeMs = maxSearchMs;
+        int threads = 0;
+        cmd.intArg(1, threads);
+        if (maxSearchThreads > 0 && (threads <= 0 || threads > maxSearchThreads)) threads = maxSearchThreads;
+
+        std::shared_ptr<const AbstractGame> position = game;
+        SearchTask task = [position, timeMs, threads](SearchEngines& e) { return runSearch(*position, e, timeMs, threads); };
+        if (searchRunner) {
+            searching = true;
+            searchRunner(std::move(task));
+            return nullptr;
+        }
+        return applySearch(task(engines));
+    }
+    case CommandId::BOOK: {
+        if (cmd.arg(0) == "load") {
+            if (!allowFiles) return "当前会话不允许读写文件";
+            std::string file(cmd.arg(1));
+            book = std::make_shared<const OpeningBook>(file);
+            ui->onMessage("开局库已载入: " + file + " (" + std::to_string(book->size()) + " 个局面)");
+            return nullptr;
+        }
+        if (!book) return "未载入开局库";
+        if (!game) return "游戏未开始";
+        OpeningBook::BookMove bm;
+        if (!book->probe(*game, bm)) {
+            ui->onMessage("开局库中没有当前局面");
+            return nullptr;
+        }
+        std::stringstream info;
+        if (bm.pass) info << "开局库: 停一手";
+        else info << "开局库: " << bm.x + 1 << " " << bm.y + 1;
+        info << " (对局 " << bm.games << " 局, 胜率 " << (int)(bm.winRate * 100) << "%)";
+        ui->onMessage(info.str());
+        return nullptr;
+    }
+    case CommandId::HINT:
+        ui->toggleHints();
+        return nullptr;
+    case CommandId::UNKNOWN:
+        break;
+    }
+    return "未知指令";
+}
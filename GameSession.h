@@ -0,0 +1,82 @@
+#ifndef GAMESESSION_H
+#define GAMESESSION_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "AbstractGame.h"
+#include "ConsoleUI.h"
+#include "GomokuEngine.h"
+#include "GoMcts.h"
+#include "OpeningBook.h"
+
+struct Command;
+
+// genmove 使用的搜索引擎，同一时刻只能跑一个搜索
+struct SearchEngines {
+    std::unique_ptr<GomokuEngine> gomoku; // 首次使用时创建，置换表在对局间复用
+    std::unique_ptr<GoMcts> go;           // 首次使用时创建，节点池在对局间复用
+};
+
+// 一次 genmove 搜索的结果，回到会话所在线程后由 finishSearch 落子
+struct SearchOutcome {
+    bool found = false;  // 为 false 时没有可以落子的位置
+    bool pass = false;
+    int x = -1, y = -1;
+    std::string info;    // 附在“电脑落子”之后的搜索统计
+    std::string error;   // 非空时搜索失败（如引擎内存分配失败）
+};
+
+// 搜索任务：用给定的引擎搜索当前局面，只读对局
+using SearchTask = std::function<SearchOutcome(SearchEngines&)>;
+// 搜索执行器：接管任务放到别的线程上运行，完成后须回到会话所在线程调用 GameSession::finishSearch
+using SearchRunner = std::function<void(SearchTask)>;
+
+// 一个会话：一盘对局及其界面，解释一行行的文本指令
+// 控制台只有一个会话；服务器为每个连接各建一个，指令语法完全相同
+class GameSession {
+private:
+    GameArena arena; // 本会话对局的内存区，开新局时整体收回；须先于 game 声明，保证最后析构
+    // 交互对局会反复落子、悔棋，单个释放的内存须能复用（内存区本身不回收单个释放），
+    // 对局从内存区之上的池分配：悔棋释放的局面表节点等由池收回，供下一步使用
+    std::pmr::unsynchronized_pool_resource pool{&arena};
+    std::shared_ptr<AbstractGame> game;
+    std::shared_ptr<ConsoleUI> ui;
+    SearchEngines engines;                      // 没有搜索执行器时在本线程搜索所用的引擎
+    SearchRunner searchRunner;                  // 为空时 genmove 在本线程同步搜索
+    std::shared_ptr<const OpeningBook> book;    // 开局库（只读映射，服务器的各会话共用一份），genmove 先查库再搜索
+    bool allowFiles; // 是否允许 save/load/sgfsave/sgfload 访问本机文件
+    bool running;
+    bool searching = false;
+    int maxSearchMs = 0;      // genmove 思考时间上限，0 表示不限
+    int maxSearchThreads = 0; // genmove 搜索线程数上限，0 表示不限
+
+    const char* execute(const Command& cmd);
+    void discardGame(); // 销毁当前对局并收回它的全部内存
+    const char* applySearch(const SearchOutcome& outcome);
+    void reportError(const char* error);
+
+public:
+    explicit GameSession(std::shared_ptr<ConsoleUI> view, bool files = true);
+
+    // 处理一行指令，返回 false 表示会话已结束（exit）
+    bool processCommand(std::string_view line);
+    bool isRunning() const { return running; }
+
+    void setOpeningBook(std::shared_ptr<const OpeningBook> b) { book = std::move(b); }
+
+    // 限制客户端可以要求的思考时间与线程数（0 表示不限），超出或未指定时按上限搜索
+    void setSearchLimits(int maxMs, int maxThreads) {
+        maxSearchMs = maxMs;
+        maxSearchThreads = maxThreads;
+    }
+
+    // 设置后 genmove 把搜索交给执行器：任务只读对局，搜索期间 isSearching() 为 true，
+    // 调用方不得再送入指令，也不得销毁会话，直到在本会话所在线程上调用 finishSearch
+    void setSearchRunner(SearchRunner runner) { searchRunner = std::move(runner); }
+    bool isSearching() const { return searching; }
+    void finishSearch(const SearchOutcome& outcome);
+};
+
+#endif // GAMESESSION_H
@@ -1,140 +1,31 @@
 #include "GameSystem.h"
 #include "UIBuilder.h"
-#include "GameFactory.h"
-#include <sstream>
-#include <fstream>
 #include <iostream>
 
-// ʵ
+// 单例实例
 GameSystem* GameSystem::instance = nullptr;
 
-// ˽й캯
-GameSystem::GameSystem() : running(true) {
+// 私有构造函数
+GameSystem::GameSystem() {
     StandardUIBuilder builder;
     ui = builder.build();
+    session = std::make_shared<GameSession>(ui);
 }
 
-// ȡ
+// 单例获取方法
 GameSystem* GameSystem::getInstance() {
     if (instance == nullptr) instance = new GameSystem();
     return instance;
 }
 
-// ѭ
+// 主运行循环
 void GameSystem::run() {
     ui->render();
     std::string line;
-    while (running && std::getline(std::cin, line)) {
+    while (std::getline(std::cin, line)) {
         if (line.empty()) continue;
-        processCommand(line);
-    }
-}
-
-// 
-void GameSystem::processCommand(const std::string& line) {
-    std::stringstream ss(line);
-    std::string cmd;
-    ss >> cmd;
-    bool needRender = true;
-    
-    try {
-        if (cmd == "exit") {
-            running = false;
-            needRender = false;
-        } else if (cmd == "help") {
-            std::string help = "ָб:\n"
-                               "  start gomoku|go [8-19] : ʼϷ\n"
-                               "  move x y :  ( У1ʼ)\n"
-                               "  pass : ͣһ (Χ)\n"
-                               "  undo : \n"
-                               "  resign : \n"
-                               "  save filename : \n"
-                               "  load filename : ȡ\n"
-                               "  hint : ʾ\n"
-                               "  exit : ˳";
-            ui->onMessage(help);
-        } else if (cmd == "start") {
-            std::string typeStr;
-            int size;
-            ss >> typeStr >> size;
-            if (size < 8 || size > 19) throw GameException("ߴ 8  19 ֮");
-            
-            // ѡӦĹ
-            std::shared_ptr<IGameFactory> factory;
-            if (typeStr == "go") {
-                factory = std::make_shared<GoFactory>();
-            } else if (typeStr == "gomoku") {
-                factory = std::make_shared<GomokuFactory>();
-            } else {
-                throw GameException("δ֪Ϸͣ go  gomoku");
-            }
-
-            // ʹùƷ
-            game = factory->createGame(size);
-            ui->updateGameStatus(getGameName(game->getType()));
-            
-            game->addObserver(ui);
-            game->refresh();
-        } else if (cmd == "move") {
-            if (!game) throw GameException("Ϸδʼ");
-            int r, c;
-            ss >> r >> c;
-            game->makeMove(r - 1, c - 1); // û1-basedڲ0-based
-        } else if (cmd == "pass") {
-            if (!game) throw GameException("Ϸδʼ");
-            game->passTurn();
-        } else if (cmd == "undo") {
-            if (!game) throw GameException("Ϸδʼ");
-            game->undo();
-        } else if (cmd == "resign") {
-            if (!game) throw GameException("Ϸδʼ");
-            game->resign();
-            game = nullptr; // 
-        } else if (cmd == "save") {
-            if (!game) throw GameException("Ϸδʼ");
-            std::string file;
-            ss >> file;
-            std::ofstream ofs(file);
-            if (!ofs) throw GameException("ļʧ");
-            ofs << game->createMemento()->serialize();
-            ui->onMessage("Ϸѱ " + file);
-        } else if (cmd == "load") {
-            std::string file;
-            ss >> file;
-            std::ifstream ifs(file);
-            if (!ifs) throw GameException("ļȡʧ");
-            
-            // л¼
-            auto mem = GameMemento::deserialize(ifs);
-            
-            // ݴ浵¼Ϸѡ񹤳
-            std::shared_ptr<IGameFactory> factory;
-            if (mem->getGameType() == GameType::GO) {
-                factory = std::make_shared<GoFactory>();
-            } else {
-                factory = std::make_shared<GomokuFactory>();
-            }
-
-            // ؽϷָ״̬
-            game = factory->createGame(mem->getBoardSize());
-            game->restoreMemento(mem);
-            
-            ui->updateGameStatus(getGameName(game->getType()));
-            game->addObserver(ui);
-            game->refresh();
-            ui->onMessage("ϷѶȡ: " + file);
-        } else if (cmd == "hint") {
-            ui->toggleHints();
-        } else {
-            throw GameException("δָ֪");
-        }
-    } catch (const std::exception& e) {
-        // 쳣UIʾ
-        ui->onMessage(std::string(": ") + e.what());
-    }
-    
-    // ȷִкˢ
-    if (running && needRender) {
-         ui->render();
+        if (!session->processCommand(line)) break;
+        // 确保命令执行后刷新
+        ui->render();
     }
 }
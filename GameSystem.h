@@ -3,23 +3,21 @@
 
 #include <memory>
 #include <string>
-#include "AbstractGame.h"
 #include "ConsoleUI.h"
+#include "GameSession.h"
 
-// ϵͳSingleton + Facade pattern
+// 系统控制器（Singleton + Facade pattern）
 class GameSystem {
 private:
     static GameSystem* instance;
-    std::shared_ptr<AbstractGame> game;
     std::shared_ptr<ConsoleUI> ui;
-    bool running;
+    std::shared_ptr<GameSession> session; // 标准输入输出上的唯一会话
 
     GameSystem();
 
 public:
     static GameSystem* getInstance();
     void run();
-    void processCommand(const std::string& line);
 };
 
 #endif // GAMESYSTEM_H
@@ -4,11 +4,11 @@
 #include <string>
 #include <exception>
 
-// öٶ
+// 枚举定义
 enum class PieceColor { NONE, BLACK, WHITE };
 enum class GameType { GOMOKU, GO };
 
-// Զ쳣
+// 自定义异常类
 class GameException : public std::exception {
 private:
     std::string msg;
@@ -17,23 +17,38 @@ public:
     const char* what() const noexcept override { return msg.c_str(); }
 };
 
-// ߺɫתΪַ
+// 落子检查结果：常见的非法落子用返回值报告，不抛异常
+enum class MoveStatus { OK, OUT_OF_RANGE, OCCUPIED, SUICIDE, KO, PASS_NOT_ALLOWED, GAME_OVER };
+
+inline const char* moveStatusText(MoveStatus s) {
+    switch (s) {
+    case MoveStatus::OUT_OF_RANGE: return "坐标超出范围";
+    case MoveStatus::OCCUPIED: return "此处不可落子";
+    case MoveStatus::SUICIDE: return "禁止自杀";
+    case MoveStatus::KO: return "全局同形，此处暂不可落子（打劫）";
+    case MoveStatus::PASS_NOT_ALLOWED: return "五子棋不能停一手";
+    case MoveStatus::GAME_OVER: return "游戏已结束";
+    default: return "";
+    }
+}
+
+// 工具函数：将颜色转为字符串
 inline std::string colorToString(PieceColor c) {
     if (c == PieceColor::BLACK) return "BLACK";
     if (c == PieceColor::WHITE) return "WHITE";
     return "NONE";
 }
 
-// ߺַתΪɫ
+// 工具函数：将字符串转为颜色
 inline PieceColor stringToColor(const std::string& s) {
     if (s == "BLACK") return PieceColor::BLACK;
     if (s == "WHITE") return PieceColor::WHITE;
     return PieceColor::NONE;
 }
 
-// ߺȡϷ
+// 工具函数：获取游戏名称
 inline std::string getGameName(GameType t) {
-    return (t == GameType::GOMOKU) ? "" : "Χ";
+    return (t == GameType::GOMOKU) ? "五子棋" : "围棋";
 }
 
 #endif // GAMETYPES_H
@@ -0,0 +1,80 @@
+#ifndef GOBOARD_H
+#define GOBOARD_H
+
+#include <cstdint>
+#include "Board.h"
+#include "GoChains.h"
+#include "Zobrist.h"
+
+// 轻量围棋棋盘：供搜索与随机对局使用，不经过 AbstractGame 的通知与历史记录
+// 只含定长数组，按值拷贝即可得到独立副本；规则为禁自杀 + 单劫（不做全局同形判断）
+class GoBoard {
+private:
+    Board board;
+    GoChains chains;
+    uint8_t side = Board::BLACK; // 行棋方
+    int koPoint = -1;            // 当前禁止回提的点
+    int passes = 0;              // 连续停手次数
+    uint64_t hash = 0;           // 棋子的 Zobrist 哈希（不含行棋方）
+
+public:
+    GoBoard() = default;
+    GoBoard(const Board& b, PieceColor toMove) : board(b), side(Board::fromColor(toMove)) {
+        chains.rebuild(board);
+        hash = Zobrist::hashBoard(board);
+    }
+
+    const Board& getBoard() const { return board; }
+    int getSize() const { return board.getSize(); }
+    uint8_t getSide() const { return side; }
+    int getPasses() const { return passes; }
+    uint64_t getHash() const { return hash; }
+
+    // 空点、非劫、非自杀
+    bool isLegal(int idx) const {
+        if (board.at(idx) != Board::EMPTY || idx == koPoint) return false;
+        return chains.check(board, idx, side).hasLiberty;
+    }
+
+    // 预测落子后的棋子哈希（用于根节点的全局同形过滤）
+    uint64_t hashAfter(int idx) const {
+        return hash ^ Zobrist::piece(idx, side) ^ chains.check(board, idx, side).capturedHash;
+    }
+
+    // 己方眼位：四邻都是己方或边框，且斜角的对方棋子不足以破眼
+    bool isOwnEye(int idx) const {
+        for (int d : GoChains::DIRS) {
+            uint8_t v = board.at(idx + d);
+            if (v != side && v != Board::BORDER) return false;
+        }
+        static const int DIAG[4] = {Board::STRIDE + 1, Board::STRIDE - 1, -Board::STRIDE + 1, -Board::STRIDE - 1};
+        int enemy = 0, edge = 0;
+        for (int d : DIAG) {
+            uint8_t v = board.at(idx + d);
+            if (v == Board::BORDER) edge = 1;
+            else if (v != side && v != Board::EMPTY) enemy++;
+        }
+        return enemy + edge < 2;
+    }
+
+    // 落子（调用前须确认 isLegal），返回提子数
+    int play(int idx) {
+        uint8_t opp = 3 - side;
+        hash ^= Zobrist::piece(idx, side);
+        GoChains::MoveCheck res = chains.place(board, idx, side, koPoint, [this, opp](int p) {
+            board.setAt(p, Board::EMPTY);
+            hash ^= Zobrist::piece(p, opp);
+        });
+        side = opp;
+        passes = 0;
+        return res.captured;
+    }
+
+    void pass() {
+        side = 3 - side;
+        koPoint = -1;
+        passes++;
+    }
+};
+
+#endif // GOBOARD_H
@@ -0,0 +1,242 @@
+#ifndef GOCHAINS_H
+#define GOCHAINS_H
+
+#include <cstdint>
+#include <utility>
+#include "Board.h"
+#include "Zobrist.h"
+
+// 围棋棋串跟踪（按 Board 下标索引，随落子增量维护）
+// head: 棋子所属棋串的代表点，空点为 -1
+// next: 串内棋子组成的循环链表，用于遍历整串
+// size / libs: 棋串的子数与伪气数（每个相邻空点按相邻次数计），仅代表点有效
+// hash: 串内所有棋子 Zobrist 键的异或，仅代表点有效，用于 O(1) 预测提子后的局面哈希
+// 伪气数为 0 当且仅当棋串无气，足以 O(1) 判断提子
+// 只保存定长数组，可以按值拷贝（供随机对局复制棋盘使用）
+class GoChains {
+public:
+    static constexpr int DIRS[4] = {1, -1, Board::STRIDE, -Board::STRIDE};
+
+    // 落子前的预判结果
+    struct MoveCheck {
+        bool hasLiberty;       // 落子（含提子）后己方棋串是否有气，否则为自杀
+        int captured;          // 将被提掉的子数
+        int capturedPoint;     // 只提一子时该子的位置（用于判断单劫），否则为 -1
+        uint64_t capturedHash; // 将被提掉的所有棋子的哈希
+    };
+
+private:
+    int head[Board::CAPACITY];
+    int next[Board::CAPACITY];
+    int size[Board::CAPACITY];
+    int libs[Board::CAPACITY];
+    uint64_t hash[Board::CAPACITY];
+
+    // 合并两个棋串（小串并入大串），返回合并后的代表点
+    int merge(int a, int b) {
+        if (size[a] < size[b]) std::swap(a, b);
+
+        int p = b;
+        do {
+            head[p] = a;
+            p = next[p];
+        } while (p != b);
+
+        // 拼接两个循环链表
+        std::swap(next[a], next[b]);
+        size[a] += size[b];
+        libs[a] += libs[b];
+        hash[a] ^= hash[b];
+        return a;
+    }
+
+public:
+    int headOf(int idx) const { return head[idx]; }
+    int sizeOf(int h) const { return size[h]; }
+    int libertiesOf(int h) const { return libs[h]; }
+    uint64_t hashOf(int h) const { return hash[h]; }
+
+    // 根据棋盘整体重建棋串状态
+    void rebuild(const Board& board) {
+        for (int i = 0; i < Board::CAPACITY; ++i) head[i] = -1;
+
+        int stack[Board::CAPACITY];
+        int n = board.getSize();
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                int idx = Board::index(i, j);
+                if (board.at(idx) != Board::EMPTY && head[idx] < 0) flood(board, idx, stack);
+            }
+        }
+    }
+
+    // 以 idx 为代表点洪泛整串（串内棋子的 head 须为 -1），新找到的棋子插入循环链表
+    void flood(const Board& board, int idx, int* stack) {
+        uint8_t v = board.at(idx);
+        head[idx] = idx;
+        next[idx] = idx;
+        size[idx] = 0;
+        libs[idx] = 0;
+        hash[idx] = 0;
+        int top = 0;
+        stack[top++] = idx;
+        while (top > 0) {
+            int p = stack[--top];
+            size[idx]++;
+            hash[idx] ^= Zobrist::piece(p, v);
+            for (int d : DIRS) {
+                int q = p + d;
+                uint8_t qv = board.at(q);
+                if (qv == Board::EMPTY) {
+                    libs[idx]++;
+                } else if (qv == v && head[q] < 0) {
+                    head[q] = idx;
+                    next[q] = next[idx];
+                    next[idx] = q;
+                    stack[top++] = q;
+                }
+            }
+        }
+    }
+
+    // 撤销落在 idx 的一步：调用前棋盘已复原（idx 已清空，captured 中被提的棋子已放回），棋串表仍是撤销前的状态
+    // 只重新洪泛 idx 所在的旧棋串（可能拆成几串）与放回的棋子，其余棋串只按相邻关系修正伪气数
+    void unplace(const Board& board, int idx, const int* captured, int count) {
+        int stones[Board::CAPACITY];
+        int n = 0;
+        bool redo[Board::CAPACITY] = {};
+
+        int p = idx;
+        do {
+            if (p != idx) stones[n++] = p;
+            redo[p] = true;
+            p = next[p];
+        } while (p != idx);
+        head[idx] = -1;
+        for (int k = 0; k < count; ++k) {
+            stones[n++] = captured[k];
+            redo[captured[k]] = true;
+        }
+
+        // idx 空出，相邻棋串各多一口伪气；放回的棋子各占掉相邻棋串的一口
+        for (int d : DIRS) {
+            int q = idx + d;
+            if (!redo[q] && head[q] >= 0) libs[head[q]]++;
+        }
+        for (int k = 0; k < count; ++k) {
+            for (int d : DIRS) {
+                int q = captured[k] + d;
+                if (!redo[q] && head[q] >= 0) libs[head[q]]--;
+            }
+        }
+
+        // 同色相连的棋子必然同在旧棋串或同一被提的棋串里，洪泛不会越出 stones
+        for (int k = 0; k < n; ++k) head[stones[k]] = -1;
+        int stack[Board::CAPACITY];
+        for (int k = 0; k < n; ++k) {
+            if (head[stones[k]] < 0) flood(board, stones[k], stack);
+        }
+    }
+
+    // 把刚落在 idx 的棋子并入棋串，更新相邻棋串的气（调用前棋盘上已放好该子）
+    void addStone(const Board& board, int idx) {
+        uint8_t color = board.at(idx);
+        head[idx] = idx;
+        next[idx] = idx;
+        size[idx] = 1;
+        libs[idx] = 0;
+        hash[idx] = Zobrist::piece(idx, color);
+
+        for (int d : DIRS) {
+            uint8_t v = board.at(idx + d);
+            if (v == Board::EMPTY) libs[idx]++;
+            else if (v == Board::BLACK || v == Board::WHITE) libs[head[idx + d]]--; // 该空点被占
+        }
+
+        // 与相邻的己方棋串合并
+        int h = idx;
+        for (int d : DIRS) {
+            if (board.at(idx + d) == color && head[idx + d] != h) {
+                h = merge(h, head[idx + d]);
+            }
+        }
+    }
+
+    // 移除整串，removeCell(p) 负责把棋盘上的 p 清空；返回提子数
+    template <typename F>
+    int removeChain(int h, F removeCell) {
+        int removed = size[h];
+        int p = h;
+        do {
+            int n = next[p];
+            removeCell(p);
+            head[p] = -1;
+            // 提子后该点成为相邻棋串的气
+            for (int d : DIRS) {
+                int q = p + d;
+                if (head[q] >= 0 && head[q] != h) libs[head[q]]++;
+            }
+            p = n;
+        } while (p != h);
+        return removed;
+    }
+
+    // 颜色 me 落在空点 idx（调用前须确认合法）：放子、并串、提掉气尽的对方棋串
+    // removeCell(p) 负责把棋盘上被提的 p 清空；koPoint 写入落子后的劫点（没有则为 -1）
+    // 返回落子前的预判结果（含提子数）
+    template <typename F>
+    MoveCheck place(Board& board, int idx, uint8_t me, int& koPoint, F removeCell) {
+        uint8_t opp = 3 - me;
+        MoveCheck res = check(board, idx, me);
+        board.setAt(idx, me);
+        addStone(board, idx);
+        for (int d : DIRS) {
+            int n = idx + d;
+            if (board.at(n) == opp && libs[head[n]] == 0) removeChain(head[n], removeCell);
+        }
+        // 单子提单子且落子后只剩一口气（即被提点）时形成劫
+        int h = head[idx];
+        koPoint = (res.captured == 1 && size[h] == 1 && libs[h] == 1) ? res.capturedPoint : -1;
+        return res;
+    }
+
+    // 预判颜色 me 落在空点 idx 的结果，不修改任何状态
+    MoveCheck check(const Board& board, int idx, uint8_t me) const {
+        MoveCheck res = {false, 0, -1, 0};
+        int seen[4];
+        int seenCount = 0;
+        for (int d : DIRS) {
+            uint8_t v = board.at(idx + d);
+            if (v == Board::EMPTY) {
+                res.hasLiberty = true;
+                continue;
+            }
+            if (v != Board::BLACK && v != Board::WHITE) continue;
+
+            int h = head[idx + d];
+            bool counted = false;
+            for (int k = 0; k < seenCount; ++k) counted = counted || seen[k] == h;
+            if (counted) continue;
+            seen[seenCount++] = h;
+
+            // 棋串的伪气全部来自 idx 时，落子后该串无气
+            int adjacent = 0;
+            for (int d2 : DIRS) {
+                if (head[idx + d2] == h) adjacent++;
+            }
+            bool lastLiberty = libs[h] == adjacent;
+
+            if (v == me) {
+                if (!lastLiberty) res.hasLiberty = true;
+            } else if (lastLiberty) {
+                res.capturedPoint = (res.captured == 0 && size[h] == 1) ? h : -1;
+                res.captured += size[h];
+                res.capturedHash ^= hash[h];
+                res.hasLiberty = true;
+            }
+        }
+        return res;
+    }
+};
+
+#endif // GOCHAINS_H
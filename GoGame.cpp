@@ -1,47 +1,55 @@
 #include "GoGame.h"
 
-// ʱעΧ
-GoGame::GoGame(int s) : AbstractGame(s, std::make_shared<GoMoveStrategy>(), std::make_shared<GoWinStrategy>()) {}
-
-// һӵ
-int GoGame::countLiberties(int x, int y, int color, std::set<Point>& visited) {
-    if (x < 0 || x >= size || y < 0 || y >= size) return 0;
-    if (board[x][y] == 0) return 1; // λ
-    if (board[x][y] != color) return 0; // Է
-    if (visited.count({x, y})) return 0; // ѷ
-
-    visited.insert({x, y});
-    int liberties = 0;
-    int dirs[4][2] = {{1,0}, {-1,0}, {0,1}, {0,-1}};
-    for (auto& d : dirs) {
-        liberties += countLiberties(x + d[0], y + d[1], color, visited);
-    }
-    return liberties;
+// 构造时注入围棋策略，策略对象与对局从同一内存资源分配
+GoGame::GoGame(int s, std::pmr::memory_resource* mem)
+    : AbstractGame(s, allocateShared<GoMoveStrategy>(mem), allocateShared<GoWinStrategy>(mem), mem) {
+    chains.rebuild(board);
 }
 
-// Ƴӿ
-void GoGame::removeDeadGroup(int x, int y, int color) {
-    std::set<Point> group;
-    if (countLiberties(x, y, color, group) == 0) {
-        for (auto& p : group) {
-            board[p.x][p.y] = 0; // 
-        }
-        if (!group.empty()) notifyMessage(" " + std::to_string(group.size()) + " ");
+// 移除无气的棋子块，返回提子数
+int GoGame::removeDeadGroup(int head) {
+    // 提子，同步更新局面哈希并记入悔棋记录
+    return chains.removeChain(head, [this](int p) { removeStone(p); });
+}
+
+// 落子前检查：禁止自杀与全局同形（含单劫）
+// 借助棋串的伪气数判断落子后的提子与气，借助棋串哈希得到落子后的局面键，不需要试下或比较棋盘
+MoveStatus GoGame::preMoveCheck(int x, int y) {
+    return checkPoint(Board::index(x, y));
+}
+
+MoveStatus GoGame::checkPoint(int idx) const {
+    uint8_t me = Board::fromColor(currentPlayer);
+    GoChains::MoveCheck res = chains.check(board, idx, me);
+
+    if (!res.hasLiberty) return MoveStatus::SUICIDE;
+    uint64_t key = getPositionKey() ^ Zobrist::piece(idx, me) ^ res.capturedHash;
+    if (hasSeenPosition(key)) return MoveStatus::KO;
+    return MoveStatus::OK;
+}
+
+// 先收集空点，再原地剔除不合法的点
+int GoGame::generateMoves(MoveList& out, MoveGenMode mode) const {
+    collectEmptyCells(out, mode);
+    int n = 0;
+    for (int k = 0; k < out.count; ++k) {
+        if (checkPoint(out.moves[k]) == MoveStatus::OK) out.moves[n++] = out.moves[k];
     }
+    out.count = n;
+    return n;
 }
 
-// Ӻ߼
+// 落子后处理（提子逻辑），提子数由 tryMove 统一通知
 void GoGame::postMoveProcess(int x, int y) {
-    int myColor = board[x][y];
-    int opColor = (myColor == 1) ? 2 : 1;
-    int dirs[4][2] = {{1,0}, {-1,0}, {0,1}, {0,-1}};
-
-    // ֵܶǷ
-    for (auto& d : dirs) {
-        int nx = x + d[0];
-        int ny = y + d[1];
-        if (nx >= 0 && nx < size && ny >= 0 && ny < size && board[nx][ny] == opColor) {
-            removeDeadGroup(nx, ny, opColor);
+    int idx = Board::index(x, y);
+    uint8_t opColor = (board.at(idx) == Board::BLACK) ? Board::WHITE : Board::BLACK;
+    chains.addStone(board, idx);
+
+    // 检查四周对手的棋串是否气尽，提子
+    for (int d : GoChains::DIRS) {
+        int n = idx + d;
+        if (board.at(n) == opColor && chains.libertiesOf(chains.headOf(n)) == 0) {
+            removeDeadGroup(chains.headOf(n));
         }
     }
 }
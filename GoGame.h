@@ -1,30 +1,42 @@
 #ifndef GOGAME_H
 #define GOGAME_H
 
-#include <set>
 #include "AbstractGame.h"
 #include "GoStrategy.h"
+#include "GoChains.h"
 
-// ΧϷ (򻯰棺߼)
+// 围棋游戏 (简化版：含提子逻辑)
 class GoGame : public AbstractGame {
 private:
-    struct Point { 
-        int x, y; 
-        bool operator<(const Point& o) const { return x < o.x || (x == o.x && y < o.y); } 
-    };
+    GoChains chains; // 棋串状态，随落子增量维护
 
-    // һӵ
-    int countLiberties(int x, int y, int color, std::set<Point>& visited);
-    
-    // Ƴӿ
-    void removeDeadGroup(int x, int y, int color);
+    // 移除无气的棋子块，返回提子数
+    int removeDeadGroup(int head);
+
+    // 当前行棋方落在空点 idx 的合法性（自杀、同形），preMoveCheck 与 generateMoves 共用
+    MoveStatus checkPoint(int idx) const;
+
+protected:
+    void onBoardRestored() override { chains.rebuild(board); }
+    void onMoveReverted(int idx, const int* captured, int count) override { chains.unplace(board, idx, captured, count); }
 
 public:
-    // ʱעΧ
-    GoGame(int s);
+    // 构造时注入围棋策略
+    GoGame(int s, std::pmr::memory_resource* mem = std::pmr::get_default_resource());
     
     GameType getType() const override { return GameType::GO; }
+    MoveStatus preMoveCheck(int x, int y) override;
     void postMoveProcess(int x, int y) override;
+
+    const GoChains& getChains() const { return chains; }
+
+    // 不含自杀与同形（劫）的着法
+    int generateMoves(MoveList& out, MoveGenMode mode = MoveGenMode::ALL) const override;
+
+    // 终局结算前估计死子，见 GoWinStrategy::setDeadStoneEstimation
+    void setDeadStoneEstimation(const OwnershipConfig& cfg) {
+        static_cast<GoWinStrategy&>(*winStrategy).setDeadStoneEstimation(cfg);
+    }
 };
 
 #endif // GOGAME_H
@@ -0,0 +1,242 @@
+#include "GoMcts.h"
+#include "GoGame.h"
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+
+uint64_t nextRandom(uint64_t& s) {
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    return s;
+}
+
+} // namespace
+
+GoMcts::GoMcts(size_t maxNodes) : pool(new Node[maxNodes]), capacity(maxNodes) {}
+
+// 从节点池分配 count 个连续节点，池满返回 -1
+int GoMcts::allocate(int count) {
+    size_t start = used.fetch_add(count, std::memory_order_relaxed);
+    if (start + count > capacity) return -1;
+    for (int k = 0; k < count; ++k) {
+        Node& n = pool[start + k];
+        n.visits.store(0, std::memory_order_relaxed);
+        n.wins.store(0, std::memory_order_relaxed);
+        n.firstChild.store(-1, std::memory_order_relaxed);
+        n.childCount.store(0, std::memory_order_relaxed);
+        n.state.store(0, std::memory_order_relaxed);
+        n.move = PASS_MOVE;
+    }
+    return (int)start;
+}
+
+// 展开节点：为所有合法且不填己方眼的点以及停一手各建一个子节点
+// 根节点额外用对局的局面历史过滤全局同形
+void GoMcts::expand(int nodeIdx, const GoBoard& b, const GoGame* rootGame) {
+    Node& node = pool[nodeIdx];
+    int expected = 0;
+    if (!node.state.compare_exchange_strong(expected, 1, std::memory_order_acquire)) return;
+
+    int moves[Board::CAPACITY];
+    int n = 0;
+    int size = b.getSize();
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            int idx = Board::index(i, j);
+            if (!b.isLegal(idx) || b.isOwnEye(idx)) continue;
+            if (rootGame && rootGame->hasSeenPosition(b.hashAfter(idx))) continue;
+            moves[n++] = idx;
+        }
+    }
+    moves[n++] = PASS_MOVE;
+
+    int first = allocate(n);
+    if (first < 0) {
+        node.state.store(3, std::memory_order_release);
+        return;
+    }
+    for (int k = 0; k < n; ++k) pool[first + k].move = moves[k];
+    node.childCount.store(n, std::memory_order_relaxed);
+    node.firstChild.store(first, std::memory_order_relaxed);
+    node.state.store(2, std::memory_order_release);
+}
+
+// UCT 选择：未访问的子节点优先，否则取 胜率 + 探索项 最大者
+int GoMcts::selectChild(const Node& node) const {
+    int first = node.firstChild.load(std::memory_order_relaxed);
+    int count = node.childCount.load(std::memory_order_relaxed);
+    double logParent = std::log((double)node.visits.load(std::memory_order_relaxed) + 1.0);
+
+    int best = first;
+    double bestValue = -1.0;
+    for (int k = 0; k < count; ++k) {
+        const Node& c = pool[first + k];
+        int v = c.visits.load(std::memory_order_relaxed);
+        if (v == 0) return first + k;
+        double q = (double)c.wins.load(std::memory_order_relaxed) / v;
+        double value = q + exploration * std::sqrt(logParent / v);
+        if (value > bestValue) {
+            bestValue = value;
+            best = first + k;
+        }
+    }
+    return best;
+}
+
+// 随机对局到双方停手，返回胜方
+// 空点表随落子增量维护，有提子时整体重建
+uint8_t GoMcts::playout(GoBoard& b, uint64_t& rng) {
+    int size = b.getSize();
+    int empties[Board::CAPACITY];
+    int pos[Board::CAPACITY];
+    int n = 0;
+    auto rebuild = [&]() {
+        n = 0;
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                int idx = Board::index(i, j);
+                if (b.getBoard().at(idx) == Board::EMPTY) {
+                    pos[idx] = n;
+                    empties[n++] = idx;
+                }
+            }
+        }
+    };
+    rebuild();
+
+    int limit = size * size * 3;
+    for (int moves = 0; moves < limit && b.getPasses() < 2; ++moves) {
+        int found = -1;
+        if (n > 0) {
+            int start = (int)(nextRandom(rng) % n);
+            for (int k = 0; k < n; ++k) {
+                int idx = empties[(start + k) % n];
+                if (!b.isOwnEye(idx) && b.isLegal(idx)) {
+                    found = idx;
+                    break;
+                }
+            }
+        }
+        if (found < 0) {
+            b.pass();
+            continue;
+        }
+        if (b.play(found) > 0) {
+            rebuild();
+        } else {
+            int last = empties[--n];
+            empties[pos[found]] = last;
+            pos[last] = pos[found];
+        }
+    }
+
+    GoWinStrategy::AreaScore area = GoWinStrategy::countArea(b.getBoard());
+    return area.black() > area.white() ? Board::BLACK : Board::WHITE;
+}
+
+// 工作线程：反复执行 选择 -> 展开 -> 随机对局 -> 回传
+void GoMcts::worker(const GoBoard& root, std::chrono::steady_clock::time_point deadline, bool timed,
+                    long maxPlayouts, std::atomic<long>& playouts, std::atomic<bool>& stop, uint64_t seed) {
+    uint64_t rng = seed | 1;
+    int path[MAX_PATH];
+    uint8_t mover[MAX_PATH];
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        GoBoard b = root;
+        int depth = 0;
+        int nodeIdx = 0;
+        path[depth] = 0;
+        mover[depth] = 0;
+        depth++;
+
+        // 选择：沿已展开节点下降，每经过一个子节点先记一次虚拟损失
+        while (pool[nodeIdx].state.load(std::memory_order_acquire) == 2 && depth < MAX_PATH && b.getPasses() < 2) {
+            int child = selectChild(pool[nodeIdx]);
+            pool[child].visits.fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+            mover[depth] = b.getSide();
+            if (pool[child].move == PASS_MOVE) b.pass();
+            else b.play(pool[child].move);
+            path[depth++] = child;
+            nodeIdx = child;
+        }
+
+        // 展开：访问次数足够的叶子节点
+        if (pool[nodeIdx].state.load(std::memory_order_relaxed) == 0 &&
+            pool[nodeIdx].visits.load(std::memory_order_relaxed) >= EXPAND_VISITS) {
+            expand(nodeIdx, b, nullptr);
+        }
+
+        // 模拟与回传：撤销虚拟损失并记入真实结果
+        uint8_t winner = playout(b, rng);
+        pool[0].visits.fetch_add(1, std::memory_order_relaxed);
+        for (int k = 1; k < depth; ++k) {
+            Node& n = pool[path[k]];
+            n.visits.fetch_add(1 - VIRTUAL_LOSS, std::memory_order_relaxed);
+            if (mover[k] == winner) n.wins.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        long done = playouts.fetch_add(1, std::memory_order_relaxed) + 1;
+        if ((maxPlayouts > 0 && done >= maxPlayouts) || (timed && std::chrono::steady_clock::now() >= deadline)) {
+            stop.store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+// 对围棋当前局面搜索一步
+MctsResult GoMcts::search(const GoGame& game, const MctsLimits& limits) {
+    auto start = std::chrono::steady_clock::now();
+    GoBoard root(game.getBoard(), game.getCurrentPlayer());
+
+    used.store(0, std::memory_order_relaxed);
+    allocate(1);
+    expand(0, root, &game);
+
+    int threads = limits.threads;
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+
+    std::atomic<long> playouts{0};
+    std::atomic<bool> stop{false};
+    bool timed = limits.timeMs > 0;
+    if (!timed && limits.maxPlayouts <= 0) stop = true; // 没有任何限制时不搜索
+    auto deadline = start + std::chrono::milliseconds(limits.timeMs);
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; ++t) {
+        workers.emplace_back(&GoMcts::worker, this, std::cref(root), deadline, timed, limits.maxPlayouts,
+                             std::ref(playouts), std::ref(stop), 0x9E3779B97F4A7C15ULL * (t + 1));
+    }
+    worker(root, deadline, timed, limits.maxPlayouts, playouts, stop, 0x9E3779B97F4A7C15ULL);
+    for (auto& w : workers) w.join();
+
+    // 选访问次数最多的着法
+    MctsResult result;
+    const Node& r = pool[0];
+    int first = r.firstChild.load();
+    int count = r.childCount.load();
+    int best = -1;
+    for (int k = 0; k < count; ++k) {
+        if (best < 0 || pool[first + k].visits.load() > pool[best].visits.load()) best = first + k;
+    }
+    if (best >= 0) {
+        const Node& c = pool[best];
+        result.pass = c.move == PASS_MOVE;
+        if (!result.pass) {
+            result.x = Board::rowOf(c.move);
+            result.y = Board::colOf(c.move);
+        }
+        int v = c.visits.load();
+        result.winRate = v > 0 ? (double)c.wins.load() / v : 0;
+    } else {
+        result.pass = true;
+    }
+
+    result.playouts = playouts.load();
+    result.threads = threads;
+    result.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    result.playoutsPerSec = result.elapsedMs > 0 ? result.playouts * 1000.0 / result.elapsedMs : 0;
+    return result;
+}
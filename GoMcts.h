@@ -0,0 +1,71 @@
+#ifndef GOMCTS_H
+#define GOMCTS_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "GoBoard.h"
+
+class GoGame;
+
+// 搜索限制：时间与随机对局数任一用尽即停止
+struct MctsLimits {
+    int timeMs = 1000;     // 0 表示不限时，此时须设 maxPlayouts（两者都为 0 时不搜索，直接返回第一个候选）
+    long maxPlayouts = 0;  // 0 表示不限次数
+    int threads = 0;       // 0 表示使用全部硬件线程
+};
+
+// 搜索结果
+struct MctsResult {
+    int x = -1, y = -1;    // 最佳落点
+    bool pass = false;     // 最佳选择为停一手
+    double winRate = 0;    // 最佳着法的估计胜率（行棋方视角）
+    long playouts = 0;
+    int threads = 0;
+    double elapsedMs = 0;
+    double playoutsPerSec = 0;
+};
+
+// 围棋蒙特卡洛树搜索：UCT 选择 + 树并行
+// 多个工作线程共享一棵树，节点统计量为原子变量；下降时加虚拟损失，使并发线程分散到不同分支
+// 随机对局在 GoBoard 副本上进行，终局按 GoWinStrategy::countArea 数子
+class GoMcts {
+private:
+    static constexpr int PASS_MOVE = -1;
+    static constexpr int VIRTUAL_LOSS = 3;
+    static constexpr int EXPAND_VISITS = 8;  // 节点访问达到该次数后才展开
+    static constexpr int MAX_PATH = 1024;
+
+    // 树节点：所有节点来自预先分配的节点池，整棵树随下一次搜索整体复用
+    struct Node {
+        std::atomic<int> visits{0};
+        std::atomic<int> wins{0};        // 以走入该节点的一方计的胜局数
+        std::atomic<int> firstChild{-1};
+        std::atomic<int> childCount{0};
+        std::atomic<int> state{0};       // 0 未展开, 1 展开中, 2 已展开, 3 节点池已满不再展开
+        int move = PASS_MOVE;
+    };
+
+    std::unique_ptr<Node[]> pool;
+    size_t capacity;
+    std::atomic<size_t> used{0};
+    double exploration = 1.0;
+
+    int allocate(int count);
+    void expand(int nodeIdx, const GoBoard& b, const GoGame* rootGame);
+    int selectChild(const Node& node) const;
+    void worker(const GoBoard& root, std::chrono::steady_clock::time_point deadline, bool timed,
+                long maxPlayouts, std::atomic<long>& playouts, std::atomic<bool>& stop, uint64_t seed);
+
+public:
+    explicit GoMcts(size_t maxNodes = (size_t)1 << 20);
+
+    MctsResult search(const GoGame& game, const MctsLimits& limits);
+
+    // 在 b 上随机对局到双方停手（只不填己方眼），返回数子胜方；结束后 b 即终局局面
+    static uint8_t playout(GoBoard& b, uint64_t& rng);
+};
+
+#endif // GOMCTS_H
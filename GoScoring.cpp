@@ -0,0 +1,145 @@
+#include "GoScoring.h"
+#include "GoBoard.h"
+#include "GoMcts.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+GoScorer::GoScorer() {
+    std::memset(mark, 0, sizeof(mark));
+}
+
+void GoScorer::owners(const Board& board, uint8_t out[Board::CAPACITY]) {
+    if (++epoch == 0) { // 轮次编号回绕时清一次标记
+        std::memset(mark, 0, sizeof(mark));
+        epoch = 1;
+    }
+    int size = board.getSize();
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            int start = Board::index(i, j);
+            uint8_t v = board.at(start);
+            if (v != Board::EMPTY) {
+                out[start] = v;
+                continue;
+            }
+            if (mark[start] == epoch) continue;
+
+            // 展开整块空地：边框格子既不是空点也不是棋子，自然挡住，无需越界判断
+            int n = 0, head = 0;
+            uint8_t touch = 0; // 位 1 黑，位 2 白
+            queue[n++] = start;
+            mark[start] = epoch;
+            while (head < n) {
+                int p = queue[head++];
+                for (int d : GoChains::DIRS) {
+                    int q = p + d;
+                    uint8_t c = board.at(q);
+                    if (c == Board::EMPTY) {
+                        if (mark[q] != epoch) {
+                            mark[q] = epoch;
+                            queue[n++] = q;
+                        }
+                    } else if (c != Board::BORDER) {
+                        touch |= c;
+                    }
+                }
+            }
+            uint8_t owner = (touch == Board::BLACK || touch == Board::WHITE) ? touch : Board::EMPTY;
+            for (int k = 0; k < n; ++k) out[queue[k]] = owner;
+        }
+    }
+}
+
+GoAreaScore GoScorer::countArea(const Board& board) {
+    uint8_t own[Board::CAPACITY];
+    owners(board, own);
+    GoAreaScore area;
+    int size = board.getSize();
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            int idx = Board::index(i, j);
+            bool stone = board.at(idx) != Board::EMPTY;
+            if (own[idx] == Board::BLACK) (stone ? area.blackStones : area.blackTerritory)++;
+            else if (own[idx] == Board::WHITE) (stone ? area.whiteStones : area.whiteTerritory)++;
+        }
+    }
+    return area;
+}
+
+GoAreaScore GoScorer::countAreaWithDeadStones(const Board& board, const OwnershipMap& ownership, double threshold) {
+    Board alive = board;
+    int blackDead = 0, whiteDead = 0;
+    int size = board.getSize();
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            int idx = Board::index(i, j);
+            uint8_t v = board.at(idx);
+            if (v == Board::BLACK && ownership.own[idx] < -threshold) {
+                alive.setAt(idx, Board::EMPTY);
+                blackDead++;
+            } else if (v == Board::WHITE && ownership.own[idx] > threshold) {
+                alive.setAt(idx, Board::EMPTY);
+                whiteDead++;
+            }
+        }
+    }
+    GoAreaScore area = countArea(alive);
+    area.blackDead = blackDead;
+    area.whiteDead = whiteDead;
+    return area;
+}
+
+void GoScorer::estimateOwnership(const Board& board, const OwnershipConfig& cfg, OwnershipMap& out) {
+    int size = board.getSize();
+    out.size = size;
+    out.playouts = std::max(cfg.playouts, 0);
+    std::fill(out.own, out.own + Board::CAPACITY, 0.0f);
+    if (out.playouts == 0) return;
+
+    int threads = cfg.threads;
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    threads = std::max(1, std::min(threads, out.playouts));
+
+    // 每个线程一份计数（黑 +1，白 -1），结束后合并，累计过程不需要同步
+    std::vector<std::vector<int>> sums(threads, std::vector<int>(Board::CAPACITY, 0));
+    std::atomic<int> next{0};
+    const GoBoard blackFirst(board, PieceColor::BLACK);
+    const GoBoard whiteFirst(board, PieceColor::WHITE);
+
+    auto work = [&](int t) {
+        GoScorer scorer;
+        uint8_t own[Board::CAPACITY];
+        int* sum = sums[t].data();
+        uint64_t rng = (cfg.seed * 0x9E3779B97F4A7C15ULL + (uint64_t)t * 0xBF58476D1CE4E5B9ULL) | 1;
+        for (int k = next++; k < out.playouts; k = next++) {
+            GoBoard b = (k & 1) ? whiteFirst : blackFirst;
+            GoMcts::playout(b, rng);
+            scorer.owners(b.getBoard(), own);
+            for (int i = 0; i < size; ++i) {
+                const uint8_t* row = own + Board::index(i, 0);
+                int* s = sum + Board::index(i, 0);
+                for (int j = 0; j < size; ++j) {
+                    s[j] += (row[j] == Board::BLACK) - (row[j] == Board::WHITE);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; ++t) workers.emplace_back(work, t);
+    work(0);
+    for (auto& w : workers) w.join();
+
+    float scale = 1.0f / out.playouts;
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            int idx = Board::index(i, j);
+            int total = 0;
+            for (int t = 0; t < threads; ++t) total += sums[t][idx];
+            out.own[idx] = total * scale;
+        }
+    }
+}
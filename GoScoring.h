@@ -0,0 +1,63 @@
+#ifndef GOSCORING_H
+#define GOSCORING_H
+
+#include <cstdint>
+#include "Board.h"
+
+// 数子法结果：子数 + 只与一方相邻的空地
+struct GoAreaScore {
+    static constexpr double KOMI = 3.75; // 贴目
+
+    int blackStones = 0, whiteStones = 0;
+    int blackTerritory = 0, whiteTerritory = 0;
+    int blackDead = 0, whiteDead = 0; // 判为死子并提走的棋子数（只在估计死子时非 0）
+    double black() const { return blackStones + blackTerritory; }
+    double white() const { return whiteStones + whiteTerritory + KOMI; }
+};
+
+// 死子估计配置
+struct OwnershipConfig {
+    int playouts = 0;        // 随机对局次数，0 表示不估计死子
+    int threads = 1;         // 0 表示使用全部硬件线程
+    double threshold = 0.5;  // 棋子所在点归属对方的程度超过该值时判为死子
+    uint64_t seed = 1;
+};
+
+// 归属图：每个点终局归黑的比例减去归白的比例，取值 [-1, 1]
+struct OwnershipMap {
+    int size = 0;
+    int playouts = 0;
+    float own[Board::CAPACITY];
+
+    float at(int x, int y) const { return own[Board::index(x, y)]; }
+};
+
+// 围棋终局结算
+// 空地用连通分量划分：按行扫描，遇到未标记的空点即以数组为队列展开整块，记录它接触到的颜色
+// 标记数组按轮次编号复用，队列与归属表都是定长数组，结算过程不分配内存
+// 死子估计：从当前局面跑多局随机对局（双方只不填己方眼），统计每个点最终归谁；
+// 多线程各自累计后再合并，归属明显偏向对方的棋子判为死子，提走后再数子
+class GoScorer {
+private:
+    uint32_t mark[Board::CAPACITY];
+    uint32_t epoch = 0;
+    int queue[Board::CAPACITY];
+
+public:
+    GoScorer();
+
+    // 计算每个点的归属：棋子为其颜色，空地为包围它的一方，双方都接触到的空地（单官）为 EMPTY
+    // 只写棋盘范围内的点
+    void owners(const Board& board, uint8_t out[Board::CAPACITY]);
+
+    // 数子（所有棋子都按活子计）
+    GoAreaScore countArea(const Board& board);
+
+    // 先按归属图提走死子，再数子
+    GoAreaScore countAreaWithDeadStones(const Board& board, const OwnershipMap& ownership, double threshold);
+
+    // 并行随机对局估计归属图（一半对局黑先，一半白先）
+    static void estimateOwnership(const Board& board, const OwnershipConfig& cfg, OwnershipMap& out);
+};
+
+#endif // GOSCORING_H
@@ -2,31 +2,40 @@
 #define GOSTRATEGY_H
 
 #include <sstream>
-#include <set>
-#include <queue>
+#include "GoScoring.h"
 #include "Strategy.h"
 
-// Χƶ
+// 围棋移动策略
 class GoMoveStrategy : public IMoveStrategy {
 public:
-    bool isValid(int x, int y, const std::vector<std::vector<int>>& board, int size) override {
-        // 򻯵Χֻп
-        // չӵĴжϣɱж
-        return board[x][y] == 0;
+    bool isValid(int x, int y, const Board& board) override {
+        // 策略层只判空
+        // 打劫与自杀禁手依赖棋串与局面历史，由 GoGame::preMoveCheck 判断
+        return board.get(x, y) == Board::EMPTY;
     }
 };
 
-// Χʤж
+// 围棋胜负判定策略
 class GoWinStrategy : public IWinStrategy {
 private:
     std::string resultDesc;
-    struct Point { int x, y; };
+    OwnershipConfig deadStones;
 
 public:
-    // Χ޸
-    // ֻ forceEnd Ϊ true (˫ͣ) ʱŽм㲢ʤ
-    // ӽ׶η NONEϷ
-    PieceColor checkWin(const std::vector<std::vector<int>>& board, int size, bool forceEnd = false) override;
+    static constexpr double KOMI = GoAreaScore::KOMI; // 贴目
+    using AreaScore = GoAreaScore;
+
+    // 对局面数子（不生成描述文本，可供随机对局终局时直接调用）
+    // 每个线程复用一份结算缓冲
+    static AreaScore countArea(const Board& board);
+
+    // 终局结算时是否先用随机对局估计并提走死子（playouts 为 0 时关闭，所有棋子按活子计）
+    void setDeadStoneEstimation(const OwnershipConfig& cfg) { deadStones = cfg; }
+
+    // 围棋策略修复：
+    // 只有在 forceEnd 为 true (双方停手) 时才进行计算并返回胜负。
+    // 否则在正常落子阶段返回 NONE，让游戏继续。
+    PieceColor checkWin(const Board& board, bool forceEnd = false) override;
     
     std::string getResultDescription() override {
         return resultDesc;
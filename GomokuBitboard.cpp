@@ -0,0 +1,271 @@
+#include "GomokuBitboard.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GOMOKU_HAVE_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+constexpr int GomokuBitboard::DIRS[4];
+
+namespace {
+
+constexpr int W = BitPlane::WORDS;
+
+int popcount64(uint64_t x) {
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+}
+
+int popcount(const BitPlane& p) {
+    int n = 0;
+    for (int i = 0; i < W; ++i) n += popcount64(p.w[i]);
+    return n;
+}
+
+// 把一行（最多 20 位）写到第 x 行的位置上
+void depositRow(BitPlane& p, int x, uint32_t bits) {
+    int pos = x * GomokuBitboard::STRIDE;
+    int off = pos & 63;
+    p.w[pos >> 6] |= (uint64_t)bits << off;
+    if (off > 64 - GomokuBitboard::STRIDE) p.w[(pos >> 6) + 1] |= (uint64_t)bits >> (64 - off);
+}
+
+// ---------------- 标量内核 ----------------
+
+// 结果第 p 位 = src 第 p+k 位；k 为负时反向移动，移出范围的位补 0
+void shiftPlane(const BitPlane& src, int k, BitPlane& dst) {
+    if (k >= 0) {
+        int q = k >> 6, r = k & 63;
+        for (int i = 0; i < W; ++i) {
+            uint64_t a = (i + q < W) ? src.w[i + q] : 0;
+            uint64_t b = (i + q + 1 < W) ? src.w[i + q + 1] : 0;
+            dst.w[i] = r ? (a >> r) | (b << (64 - r)) : a;
+        }
+    } else {
+        k = -k;
+        int q = k >> 6, r = k & 63;
+        for (int i = 0; i < W; ++i) {
+            uint64_t a = (i - q >= 0) ? src.w[i - q] : 0;
+            uint64_t b = (i - q - 1 >= 0) ? src.w[i - q - 1] : 0;
+            dst.w[i] = r ? (a << r) | (b >> (64 - r)) : a;
+        }
+    }
+}
+
+void scalarLoad(const Board& board, GomokuBitboard& out) {
+    out.black.clear();
+    out.white.clear();
+    out.empty.clear();
+    out.size = board.getSize();
+    uint32_t rowMask = (1u << out.size) - 1;
+    const uint8_t* cells = board.data();
+    for (int x = 0; x < out.size; ++x) {
+        const uint8_t* row = cells + Board::index(x, 0);
+        uint32_t b = 0, w = 0;
+        for (int y = 0; y < out.size; ++y) {
+            b |= (uint32_t)(row[y] == Board::BLACK) << y;
+            w |= (uint32_t)(row[y] == Board::WHITE) << y;
+        }
+        depositRow(out.black, x, b);
+        depositRow(out.white, x, w);
+        depositRow(out.empty, x, rowMask & ~(b | w));
+    }
+}
+
+// 沿方向 d：x = own & own>>d 得到连二，再 & x>>2d 得到连四，最后 & x>>d 得到连五
+bool scalarHasFive(const BitPlane& own) {
+    for (int d : GomokuBitboard::DIRS) {
+        BitPlane t, x;
+        shiftPlane(own, d, t);
+        for (int i = 0; i < W; ++i) x.w[i] = own.w[i] & t.w[i];
+        shiftPlane(x, 2 * d, t);
+        for (int i = 0; i < W; ++i) x.w[i] &= t.w[i];
+        shiftPlane(x, d, t);
+        uint64_t any = 0;
+        for (int i = 0; i < W; ++i) any |= x.w[i] & t.w[i];
+        if (any) return true;
+    }
+    return false;
+}
+
+// 空点 p 沿方向 d 能成五，当且仅当某个包含 p 的五格窗口中其余四格都是己方
+// s[j] 为移位后的己方位图（第 p 位 = p + j*d 处是否己方），五个窗口各取四块相与
+int scalarWinningPoints(const BitPlane& own, const BitPlane& empty, BitPlane& out) {
+    out.clear();
+    for (int d : GomokuBitboard::DIRS) {
+        BitPlane s[9];
+        for (int j = -4; j <= 4; ++j) {
+            if (j != 0) shiftPlane(own, j * d, s[j + 4]);
+        }
+        for (int k = 0; k <= 4; ++k) {
+            for (int i = 0; i < W; ++i) {
+                uint64_t acc = ~0ULL;
+                for (int j = k - 4; j <= k; ++j) {
+                    if (j != 0) acc &= s[j + 4].w[i];
+                }
+                out.w[i] |= acc;
+            }
+        }
+    }
+    for (int i = 0; i < W; ++i) out.w[i] &= empty.w[i];
+    return popcount(out);
+}
+
+const GomokuKernel SCALAR = {"scalar", scalarLoad, scalarHasFive, scalarWinningPoints};
+
+// ---------------- AVX2 内核 ----------------
+#ifdef GOMOKU_HAVE_AVX2
+
+// 一块位图放在两个 256 位寄存器里：lo 为第 0~3 字，hi 为第 4~7 字
+struct V {
+    __m256i lo, hi;
+};
+
+AVX2_TARGET inline V vload(const BitPlane& p) {
+    return {_mm256_load_si256((const __m256i*)p.w), _mm256_load_si256((const __m256i*)(p.w + 4))};
+}
+AVX2_TARGET inline void vstore(const V& v, BitPlane& p) {
+    _mm256_store_si256((__m256i*)p.w, v.lo);
+    _mm256_store_si256((__m256i*)(p.w + 4), v.hi);
+}
+AVX2_TARGET inline V vand(const V& a, const V& b) { return {_mm256_and_si256(a.lo, b.lo), _mm256_and_si256(a.hi, b.hi)}; }
+AVX2_TARGET inline V vor(const V& a, const V& b) { return {_mm256_or_si256(a.lo, b.lo), _mm256_or_si256(a.hi, b.hi)}; }
+AVX2_TARGET inline bool vzero(const V& a) {
+    __m256i m = _mm256_or_si256(a.lo, a.hi);
+    return _mm256_testz_si256(m, m) != 0;
+}
+
+// 整体下移一个字：[w1..w7, 0]
+AVX2_TARGET inline V nextWords(const V& v) {
+    __m256i rl = _mm256_permute4x64_epi64(v.lo, _MM_SHUFFLE(0, 3, 2, 1)); // w1 w2 w3 w0
+    __m256i rh = _mm256_permute4x64_epi64(v.hi, _MM_SHUFFLE(0, 3, 2, 1)); // w5 w6 w7 w4
+    return {_mm256_blend_epi32(rl, rh, 0xC0), _mm256_blend_epi32(rh, _mm256_setzero_si256(), 0xC0)};
+}
+
+// 整体上移一个字：[0, w0..w6]
+AVX2_TARGET inline V prevWords(const V& v) {
+    __m256i rl = _mm256_permute4x64_epi64(v.lo, _MM_SHUFFLE(2, 1, 0, 3)); // w3 w0 w1 w2
+    __m256i rh = _mm256_permute4x64_epi64(v.hi, _MM_SHUFFLE(2, 1, 0, 3)); // w7 w4 w5 w6
+    return {_mm256_blend_epi32(rl, _mm256_setzero_si256(), 0x03), _mm256_blend_epi32(rh, rl, 0x03)};
+}
+
+// 与 shiftPlane 含义相同
+AVX2_TARGET inline V vshift(V v, int k) {
+    if (k >= 0) {
+        for (int q = k >> 6; q > 0; --q) v = nextWords(v);
+        int r = k & 63;
+        if (r == 0) return v;
+        V n = nextWords(v);
+        __m128i cr = _mm_cvtsi32_si128(r), cl = _mm_cvtsi32_si128(64 - r);
+        return {_mm256_or_si256(_mm256_srl_epi64(v.lo, cr), _mm256_sll_epi64(n.lo, cl)),
+                _mm256_or_si256(_mm256_srl_epi64(v.hi, cr), _mm256_sll_epi64(n.hi, cl))};
+    }
+    k = -k;
+    for (int q = k >> 6; q > 0; --q) v = prevWords(v);
+    int r = k & 63;
+    if (r == 0) return v;
+    V p = prevWords(v);
+    __m128i cl = _mm_cvtsi32_si128(r), cr = _mm_cvtsi32_si128(64 - r);
+    return {_mm256_or_si256(_mm256_sll_epi64(v.lo, cl), _mm256_srl_epi64(p.lo, cr)),
+            _mm256_or_si256(_mm256_sll_epi64(v.hi, cl), _mm256_srl_epi64(p.hi, cr))};
+}
+
+// 每行一次 32 字节载入、两次比较、两次 movemask（最后一行从下标 400 读到 431，仍在缓冲区内）
+AVX2_TARGET void avx2Load(const Board& board, GomokuBitboard& out) {
+    out.black.clear();
+    out.white.clear();
+    out.empty.clear();
+    out.size = board.getSize();
+    uint32_t rowMask = (1u << out.size) - 1;
+    const uint8_t* cells = board.data();
+    const __m256i vb = _mm256_set1_epi8((char)Board::BLACK);
+    const __m256i vw = _mm256_set1_epi8((char)Board::WHITE);
+    for (int x = 0; x < out.size; ++x) {
+        __m256i row = _mm256_loadu_si256((const __m256i*)(cells + Board::index(x, 0)));
+        uint32_t b = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(row, vb)) & rowMask;
+        uint32_t w = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(row, vw)) & rowMask;
+        depositRow(out.black, x, b);
+        depositRow(out.white, x, w);
+        depositRow(out.empty, x, rowMask & ~(b | w));
+    }
+}
+
+AVX2_TARGET bool avx2HasFive(const BitPlane& own) {
+    V o = vload(own);
+    for (int d : GomokuBitboard::DIRS) {
+        V x = vand(o, vshift(o, d));
+        x = vand(x, vshift(x, 2 * d));
+        x = vand(x, vshift(x, d));
+        if (!vzero(x)) return true;
+    }
+    return false;
+}
+
+AVX2_TARGET int avx2WinningPoints(const BitPlane& own, const BitPlane& empty, BitPlane& out) {
+    V o = vload(own);
+    V res = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+    for (int d : GomokuBitboard::DIRS) {
+        V s[9];
+        for (int j = -4; j <= 4; ++j) {
+            if (j != 0) s[j + 4] = vshift(o, j * d);
+        }
+        // 五个窗口：j 取 [k-4, k]，跳过 j = 0（即空点自身）
+        V w0 = vand(vand(s[0], s[1]), vand(s[2], s[3]));
+        V w1 = vand(vand(s[1], s[2]), vand(s[3], s[5]));
+        V w2 = vand(vand(s[2], s[3]), vand(s[5], s[6]));
+        V w3 = vand(vand(s[3], s[5]), vand(s[6], s[7]));
+        V w4 = vand(vand(s[5], s[6]), vand(s[7], s[8]));
+        res = vor(res, vor(vor(w0, w1), vor(vor(w2, w3), w4)));
+    }
+    vstore(vand(res, vload(empty)), out);
+    return popcount(out);
+}
+
+const GomokuKernel AVX2 = {"avx2", avx2Load, avx2HasFive, avx2WinningPoints};
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false; // 操作系统需保存 YMM 寄存器
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // GOMOKU_HAVE_AVX2
+
+} // namespace
+
+const GomokuKernel& GomokuKernel::scalar() {
+    return SCALAR;
+}
+
+const GomokuKernel* GomokuKernel::avx2() {
+#ifdef GOMOKU_HAVE_AVX2
+    static const bool supported = cpuHasAvx2();
+    return supported ? &AVX2 : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+const GomokuKernel& GomokuKernel::best() {
+    static const GomokuKernel* chosen = avx2() ? avx2() : &SCALAR;
+    return *chosen;
+}
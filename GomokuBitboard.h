@@ -0,0 +1,49 @@
+#ifndef GOMOKUBITBOARD_H
+#define GOMOKUBITBOARD_H
+
+#include <cstdint>
+#include "Board.h"
+
+// 五子棋位棋盘：黑、白各一块位图
+// 每行占 20 位（19 列 + 1 位恒为 0 的隔离列），共 380 位，存放在 8 个 64 位字中（后两个字恒为 0，
+// 便于 AVX2 按两个 256 位寄存器处理）。隔离列保证整块位图移位时，横向与两条斜向的连线不会跨行
+// 方向对应的移位量：横 1，纵 20，主对角 21，副对角 19
+struct BitPlane {
+    static constexpr int WORDS = 8;
+    alignas(32) uint64_t w[WORDS];
+
+    void clear() {
+        for (int i = 0; i < WORDS; ++i) w[i] = 0;
+    }
+    bool test(int bit) const { return (w[bit >> 6] >> (bit & 63)) & 1; }
+    void set(int bit) { w[bit >> 6] |= 1ULL << (bit & 63); }
+};
+
+struct GomokuBitboard {
+    static constexpr int STRIDE = Board::MAX_SIZE + 1;
+    static constexpr int DIRS[4] = {1, STRIDE, STRIDE + 1, STRIDE - 1};
+
+    BitPlane black, white;
+    BitPlane empty; // 棋盘范围内的空点
+    int size = 0;
+
+    static int bit(int x, int y) { return x * STRIDE + y; }
+    const BitPlane& plane(PieceColor c) const { return c == PieceColor::BLACK ? black : white; }
+};
+
+// 位棋盘运算内核：标量版本任何平台可用；x86-64 上另有 AVX2 版本，运行时按 CPU 支持情况选择
+struct GomokuKernel {
+    const char* name;
+    // 从字节棋盘构建位棋盘
+    void (*load)(const Board& board, GomokuBitboard& out);
+    // 该颜色是否已有连五
+    bool (*hasFive)(const BitPlane& own);
+    // 冲四点：落下即成五的空点，结果写入 out，返回个数
+    int (*winningPoints)(const BitPlane& own, const BitPlane& empty, BitPlane& out);
+
+    static const GomokuKernel& scalar();
+    static const GomokuKernel* avx2(); // 未编译进来或 CPU 不支持时为 nullptr
+    static const GomokuKernel& best(); // 首次调用时检测 CPU，之后直接返回
+};
+
+#endif // GOMOKUBITBOARD_H
@@ -0,0 +1,254 @@
+#include "GomokuEngine.h"
+#include "AbstractGame.h"
+#include "Zobrist.h"
+#include <cstring>
+
+namespace {
+
+constexpr int DIRS[4] = {1, Board::STRIDE, Board::STRIDE + 1, Board::STRIDE - 1};
+
+// 五格窗口内只有一方棋子时按子数计分，活三、活四会覆盖多个窗口而自然得到更高分
+constexpr int WINDOW_SCORE[5] = {0, 1, 10, 100, 1000};
+
+} // namespace
+
+GomokuEngine::GomokuEngine(int tableBits)
+    : table((size_t)1 << tableBits), tableMask(((uint64_t)1 << tableBits) - 1) {}
+
+void GomokuEngine::clearTable() {
+    std::fill(table.begin(), table.end(), TTEntry());
+}
+
+// 在引擎棋盘上放子/提子，同步维护哈希与候选点计数
+void GomokuEngine::place(int idx, uint8_t v) {
+    board.setAt(idx, v);
+    hash ^= Zobrist::piece(idx, v);
+    for (int dx = -2; dx <= 2; ++dx) {
+        for (int dy = -2; dy <= 2; ++dy) nearCount[NEAR_OFFSET + idx + dx * Board::STRIDE + dy]++;
+    }
+}
+
+void GomokuEngine::lift(int idx) {
+    hash ^= Zobrist::piece(idx, board.at(idx));
+    board.setAt(idx, Board::EMPTY);
+    for (int dx = -2; dx <= 2; ++dx) {
+        for (int dy = -2; dy <= 2; ++dy) nearCount[NEAR_OFFSET + idx + dx * Board::STRIDE + dy]--;
+    }
+}
+
+bool GomokuEngine::timeUp() {
+    if (limits.maxNodes > 0 && nodes >= limits.maxNodes) return true;
+    if (limits.timeMs > 0 && (nodes & 1023) == 0) {
+        auto elapsed = std::chrono::steady_clock::now() - startTime;
+        if (elapsed >= std::chrono::milliseconds(limits.timeMs)) return true;
+    }
+    return false;
+}
+
+// 假设 idx 处为 color，沿方向 d 经过该点的连子数
+int GomokuEngine::lineLength(int idx, int d, uint8_t color) const {
+    int count = 1;
+    for (int p = idx + d; board.at(p) == color; p += d) ++count;
+    for (int p = idx - d; board.at(p) == color; p -= d) ++count;
+    return count;
+}
+
+// 局面评估（行棋方视角）：统计所有五格窗口
+int GomokuEngine::evaluate() const {
+    int size = board.getSize();
+    int score[3] = {0, 0, 0};
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            int idx = Board::index(i, j);
+            bool fit[4] = {j + 4 < size, i + 4 < size, i + 4 < size && j + 4 < size, i + 4 < size && j - 4 >= 0};
+            for (int k = 0; k < 4; ++k) {
+                if (!fit[k]) continue;
+                int cnt[4] = {0, 0, 0, 0};
+                for (int s = 0; s < 5; ++s) cnt[board.at(idx + s * DIRS[k])]++;
+                if (cnt[Board::WHITE] == 0) score[Board::BLACK] += WINDOW_SCORE[cnt[Board::BLACK]];
+                else if (cnt[Board::BLACK] == 0) score[Board::WHITE] += WINDOW_SCORE[cnt[Board::WHITE]];
+            }
+        }
+    }
+    return score[side] - score[3 - side];
+}
+
+// 生成候选着法并排序，返回着法数
+int GomokuEngine::generateMoves(int* moves, int ttMove) {
+    int size = board.getSize();
+    uint8_t opp = 3 - side;
+    int scores[Board::CAPACITY];
+    int n = 0;
+    int blocks[Board::CAPACITY]; // 必须封堵对方成五的点
+    int forced = 0;
+
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            int idx = Board::index(i, j);
+            if (nearCount[NEAR_OFFSET + idx] == 0 || !moveRule.isValid(i, j, board)) continue;
+
+            int mine = 0, theirs = 0, best = 0;
+            for (int d : DIRS) {
+                int a = lineLength(idx, d, side);
+                int b = lineLength(idx, d, opp);
+                mine += 1 << (2 * (a < 5 ? a : 5));
+                theirs += 1 << (2 * (b < 5 ? b : 5));
+                if (a >= 5) best = 2;
+                else if (b >= 5 && best == 0) best = 1;
+            }
+            if (best == 2) {
+                moves[0] = idx; // 直接成五
+                return 1;
+            }
+            if (best == 1) blocks[forced++] = idx;
+            moves[n] = idx;
+            scores[n] = 2 * mine + theirs + (idx == ttMove ? (1 << 30) : 0);
+            n++;
+        }
+    }
+
+    if (n == 0 && board.at(Board::index(size / 2, size / 2)) == Board::EMPTY) {
+        moves[0] = Board::index(size / 2, size / 2); // 空盘下天元
+        return 1;
+    }
+    if (forced > 0) {
+        for (int k = 0; k < forced; ++k) moves[k] = blocks[k];
+        return forced;
+    }
+
+    // 按启发分插入排序，只保留前 MAX_CANDIDATES 个
+    for (int a = 1; a < n; ++a) {
+        int m = moves[a], s = scores[a], b = a - 1;
+        while (b >= 0 && scores[b] < s) {
+            moves[b + 1] = moves[b];
+            scores[b + 1] = scores[b];
+            --b;
+        }
+        moves[b + 1] = m;
+        scores[b + 1] = s;
+    }
+    return n < MAX_CANDIDATES ? n : MAX_CANDIDATES;
+}
+
+int GomokuEngine::negamax(int depth, int alpha, int beta, int ply, int lastIdx) {
+    nodes++;
+    if (timeUp()) aborted = true;
+    if (aborted) return 0;
+
+    // 上一步是否已经成五
+    if (lastIdx >= 0 && winRule.checkWinAt(board, Board::rowOf(lastIdx), Board::colOf(lastIdx)) != PieceColor::NONE) {
+        return -(WIN_SCORE - ply);
+    }
+    if (depth == 0 || ply >= MAX_PLY) return evaluate();
+
+    // 置换表
+    TTEntry& entry = table[hash & tableMask];
+    int ttMove = -1;
+    if (entry.key == hash) {
+        ttMove = entry.move;
+        if (entry.depth >= depth) {
+            int s = entry.score;
+            if (s > WIN_SCORE - 1000) s -= ply;
+            else if (s < -WIN_SCORE + 1000) s += ply;
+            if (entry.flag == 0) return s;
+            if (entry.flag == 1 && s >= beta) return s;
+            if (entry.flag == 2 && s <= alpha) return s;
+        }
+    }
+
+    int moves[Board::CAPACITY];
+    int n = generateMoves(moves, ttMove);
+    if (n == 0) return 0; // 棋盘下满，和棋
+
+    int alphaOrig = alpha;
+    int best = -WIN_SCORE - 1;
+    int bestMove = moves[0];
+    for (int k = 0; k < n; ++k) {
+        place(moves[k], side);
+        side = 3 - side;
+        hash ^= Zobrist::side();
+        int s = -negamax(depth - 1, -beta, -alpha, ply + 1, moves[k]);
+        hash ^= Zobrist::side();
+        side = 3 - side;
+        lift(moves[k]);
+        if (aborted) return 0;
+
+        if (s > best) {
+            best = s;
+            bestMove = moves[k];
+        }
+        if (s > alpha) alpha = s;
+        if (alpha >= beta) break;
+    }
+
+    int stored = best;
+    if (stored > WIN_SCORE - 1000) stored += ply;
+    else if (stored < -WIN_SCORE + 1000) stored -= ply;
+    entry.key = hash;
+    entry.score = stored;
+    entry.move = (int16_t)bestMove;
+    entry.depth = (int8_t)depth;
+    entry.flag = best <= alphaOrig ? 2 : (best >= beta ? 1 : 0);
+    return best;
+}
+
+// 对游戏当前局面做一次迭代加深搜索
+SearchResult GomokuEngine::search(const AbstractGame& game, const SearchLimits& lim) {
+    limits = lim;
+    startTime = std::chrono::steady_clock::now();
+    nodes = 0;
+    aborted = false;
+
+    // 建立引擎自己的棋盘副本
+    board = Board(game.getSize());
+    hash = 0;
+    std::memset(nearCount, 0, sizeof(nearCount));
+    const Board& src = game.getBoard();
+    for (int i = 0; i < board.getSize(); ++i) {
+        for (int j = 0; j < board.getSize(); ++j) {
+            uint8_t v = src.get(i, j);
+            if (v != Board::EMPTY) place(Board::index(i, j), v);
+        }
+    }
+    side = Board::fromColor(game.getCurrentPlayer());
+    if (side == Board::WHITE) hash ^= Zobrist::side();
+
+    SearchResult result;
+    int rootMoves[Board::CAPACITY];
+    int bestMove = -1;
+    for (int depth = 1; depth <= limits.maxDepth; ++depth) {
+        int n = generateMoves(rootMoves, bestMove);
+        if (n == 0) break;
+
+        int alpha = -WIN_SCORE - 1, beta = WIN_SCORE + 1;
+        int iterBest = rootMoves[0], iterScore = -WIN_SCORE - 1;
+        for (int k = 0; k < n; ++k) {
+            place(rootMoves[k], side);
+            side = 3 - side;
+            hash ^= Zobrist::side();
+            int s = -negamax(depth - 1, -beta, -alpha, 1, rootMoves[k]);
+            hash ^= Zobrist::side();
+            side = 3 - side;
+            lift(rootMoves[k]);
+            if (aborted) break;
+            if (s > iterScore) {
+                iterScore = s;
+                iterBest = rootMoves[k];
+            }
+            if (s > alpha) alpha = s;
+        }
+
+        // 只采用完整完成的迭代（第一轮即使超时也至少给出一个着法）
+        if (aborted && depth > 1) break;
+        bestMove = iterBest;
+        result.x = Board::rowOf(bestMove);
+        result.y = Board::colOf(bestMove);
+        result.score = iterScore;
+        result.depth = depth;
+        if (aborted || iterScore > WIN_SCORE - 1000 || iterScore < -WIN_SCORE + 1000) break;
+    }
+
+    result.nodes = nodes;
+    result.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return result;
+}
@@ -0,0 +1,82 @@
+#ifndef GOMOKUENGINE_H
+#define GOMOKUENGINE_H
+
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include "Board.h"
+#include "GomokuStrategy.h"
+
+class AbstractGame;
+
+// 搜索限制：时间与节点数任一用尽即停止，返回最后一轮完整迭代的结果
+struct SearchLimits {
+    int maxDepth = 32;
+    int timeMs = 100;   // 0 表示不限时
+    long maxNodes = 0;  // 0 表示不限节点数
+};
+
+// 搜索结果
+struct SearchResult {
+    int x = -1, y = -1; // 最佳落点，无可下之处时为 -1
+    int score = 0;      // 以行棋方视角的评分
+    int depth = 0;      // 完成的迭代深度
+    long nodes = 0;     // 搜索节点数
+    double elapsedMs = 0;
+};
+
+// 五子棋搜索引擎：迭代加深 alpha-beta + 置换表
+// 候选点只取已有棋子两格以内的空点；有成五或必须封堵的点时只搜这些点（威胁剪枝）
+// 搜索在引擎自己的棋盘副本上进行，不经过 AbstractGame 的通知与历史记录
+class GomokuEngine {
+public:
+    static constexpr int WIN_SCORE = 1000000;
+
+private:
+    // 置换表项
+    struct TTEntry {
+        uint64_t key = 0;
+        int32_t score = 0;
+        int16_t move = -1;
+        int8_t depth = -1;
+        uint8_t flag = 0; // 0 精确值, 1 下界, 2 上界
+    };
+
+    static constexpr int MAX_PLY = 64;
+    static constexpr int MAX_CANDIDATES = 16; // 非强制局面下每层保留的候选数
+    static constexpr int NEAR_OFFSET = 2 * Board::STRIDE + 2; // nearCount 在两格外仍可写，整体偏移两行两列
+
+    Board board;
+    uint64_t hash = 0;
+    uint8_t side = Board::BLACK;
+    uint8_t nearCount[Board::CAPACITY + 2 * NEAR_OFFSET]; // 周围两格内的棋子数，>0 的空点才是候选点
+
+    GomokuMoveStrategy moveRule;
+    GomokuWinStrategy winRule;
+
+    std::vector<TTEntry> table;
+    uint64_t tableMask;
+
+    SearchLimits limits;
+    std::chrono::steady_clock::time_point startTime;
+    long nodes = 0;
+    bool aborted = false;
+
+    void place(int idx, uint8_t v);
+    void lift(int idx);
+    bool timeUp();
+
+    int evaluate() const;
+    int lineLength(int idx, int d, uint8_t color) const;
+    int generateMoves(int* moves, int ttMove);
+    int negamax(int depth, int alpha, int beta, int ply, int lastIdx);
+
+public:
+    // 置换表大小为 2^tableBits 项
+    explicit GomokuEngine(int tableBits = 18);
+
+    SearchResult search(const AbstractGame& game, const SearchLimits& lim);
+    void clearTable();
+};
+
+#endif // GOMOKUENGINE_H
@@ -4,16 +4,23 @@
 #include "AbstractGame.h"
 #include "GomokuStrategy.h"
 
-// Ϸ
+// 五子棋游戏
 class GomokuGame : public AbstractGame {
 public:
-    // ʱע
-    GomokuGame(int s) : AbstractGame(s, std::make_shared<GomokuMoveStrategy>(), std::make_shared<GomokuWinStrategy>()) {}
+    // 构造时注入五子棋策略，策略对象与对局从同一内存资源分配
+    GomokuGame(int s, std::pmr::memory_resource* mem = std::pmr::get_default_resource())
+        : AbstractGame(s, allocateShared<GomokuMoveStrategy>(mem), allocateShared<GomokuWinStrategy>(mem), mem) {}
 
     GameType getType() const override { return GameType::GOMOKU; }
 
     void postMoveProcess(int x, int y) override {
-        // ޸
+        // 五子棋无副作用
+    }
+
+    // 无禁手：所有空点都可落子
+    int generateMoves(MoveList& out, MoveGenMode mode = MoveGenMode::ALL) const override {
+        collectEmptyCells(out, mode);
+        return out.count;
     }
 };
 
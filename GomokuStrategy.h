@@ -1,40 +1,54 @@
 #ifndef GOMOKUSTRATEGY_H
 #define GOMOKUSTRATEGY_H
 
+#include "GomokuBitboard.h"
 #include "Strategy.h"
 
-// ƶ
+// 五子棋移动策略
 class GomokuMoveStrategy : public IMoveStrategy {
 public:
-    bool isValid(int x, int y, const std::vector<std::vector<int>>& board, int size) override {
-        // ֻҪԽ磨GameУҸλΪռ
-        return board[x][y] == 0;
+    bool isValid(int x, int y, const Board& board) override {
+        // 五子棋规则：只要不越界（Game类已判）且该位置为空即可
+        return board.get(x, y) == Board::EMPTY;
     }
 };
 
-// ʤж
+// 五子棋胜负判定策略
 class GomokuWinStrategy : public IWinStrategy {
 public:
-    //  forceEndΪÿһҪǷ
-    PieceColor checkWin(const std::vector<std::vector<int>>& board, int size, bool forceEnd = false) override {
-        // ĸ򣺺ᡢݡԽǡԽ
-        for (int i = 0; i < size; ++i) {
-            for (int j = 0; j < size; ++j) {
-                int c = board[i][j];
-                if (c == 0) continue;
-                // 
-                if (j + 4 < size && board[i][j+1]==c && board[i][j+2]==c && board[i][j+3]==c && board[i][j+4]==c)
-                    return (c==1 ? PieceColor::BLACK : PieceColor::WHITE);
-                // 
-                if (i + 4 < size && board[i+1][j]==c && board[i+2][j]==c && board[i+3][j]==c && board[i+4][j]==c)
-                    return (c==1 ? PieceColor::BLACK : PieceColor::WHITE);
-                // Խ
-                if (i + 4 < size && j + 4 < size && board[i+1][j+1]==c && board[i+2][j+2]==c && board[i+3][j+3]==c && board[i+4][j+4]==c)
-                    return (c==1 ? PieceColor::BLACK : PieceColor::WHITE);
-                // Խ
-                if (i + 4 < size && j - 4 >= 0 && board[i+1][j-1]==c && board[i+2][j-2]==c && board[i+3][j-3]==c && board[i+4][j-4]==c)
-                    return (c==1 ? PieceColor::BLACK : PieceColor::WHITE);
-            }
+    // 五子棋忽略 forceEnd，因为每一步都需要检查是否连五
+    // 整盘扫描改为位棋盘：每个方向三次移位相与即可找出所有连五，AVX2 可用时走向量内核
+    PieceColor checkWin(const Board& board, bool forceEnd = false) override {
+        const GomokuKernel& k = GomokuKernel::best();
+        GomokuBitboard bb;
+        k.load(board, bb);
+        if (k.hasFive(bb.black)) return PieceColor::BLACK;
+        if (k.hasFive(bb.white)) return PieceColor::WHITE;
+        return PieceColor::NONE;
+    }
+
+    // 统计 color 一方的成五点（落下即成五的空点）个数，供评估与提示使用
+    static int countThreats(const Board& board, PieceColor color) {
+        const GomokuKernel& k = GomokuKernel::best();
+        GomokuBitboard bb;
+        BitPlane points;
+        k.load(board, bb);
+        return k.winningPoints(bb.plane(color), bb.empty, points);
+    }
+
+    // 只有经过新落子的四条线可能形成连五，从该点向两侧计数即可
+    PieceColor checkWinAt(const Board& board, int x, int y) override { return fiveThrough(board, Board::index(x, y)); }
+
+    // checkWinAt 的下标版本，不经虚调用，对局内核（GameKernel）直接使用
+    static PieceColor fiveThrough(const Board& board, int idx) {
+        static const int dirs[4] = {1, Board::STRIDE, Board::STRIDE + 1, Board::STRIDE - 1};
+        uint8_t c = board.at(idx);
+        if (c != Board::BLACK && c != Board::WHITE) return PieceColor::NONE;
+        for (int d : dirs) {
+            int count = 1;
+            for (int p = idx + d; board.at(p) == c; p += d) ++count;
+            for (int p = idx - d; board.at(p) == c; p -= d) ++count;
+            if (count >= 5) return Board::toColor(c);
         }
         return PieceColor::NONE;
     }
@@ -0,0 +1,78 @@
+#include "MappedFile.h"
+#include "GameTypes.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// 打开并映射文件
+MappedFile::MappedFile(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) throw GameException("文件读取失败");
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        close();
+        throw GameException("文件读取失败");
+    }
+    length = (size_t)fileSize.QuadPart;
+    if (length == 0) return;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        close();
+        throw GameException("文件映射失败");
+    }
+    mappingHandle = mapping;
+    data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data) {
+        close();
+        throw GameException("文件映射失败");
+    }
+#else
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw GameException("文件读取失败");
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close();
+        throw GameException("文件读取失败");
+    }
+    length = (size_t)st.st_size;
+    if (length == 0) return;
+
+    void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+        close();
+        throw GameException("文件映射失败");
+    }
+    data = static_cast<const uint8_t*>(p);
+    madvise(p, length, MADV_SEQUENTIAL);
+#endif
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (data) munmap(const_cast<uint8_t*>(data), length);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    data = nullptr;
+}
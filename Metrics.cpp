@@ -0,0 +1,213 @@
+#include "Metrics.h"
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace {
+
+constexpr int METRIC_COUNT_ = (int)Metric::COUNT;
+constexpr int COUNTER_COUNT_ = (int)Counter::COUNT;
+
+// 一个线程的全部统计数据，只由该线程写入
+struct ThreadData {
+    struct Histogram {
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sumNs;
+        std::atomic<uint64_t> maxNs;
+        std::atomic<uint64_t> buckets[Metrics::BUCKETS];
+    };
+    Histogram hist[METRIC_COUNT_];
+    std::atomic<uint64_t> counters[COUNTER_COUNT_];
+};
+
+// 线程退出后数据仍保留在登记表中，汇总时照常计入；登记表本身有意不释放，避免与线程退出的先后顺序纠缠
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadData>>& registry() {
+    static auto* r = new std::vector<std::unique_ptr<ThreadData>>();
+    return *r;
+}
+
+ThreadData& local() {
+    thread_local ThreadData* data = nullptr;
+    if (!data) {
+        auto p = std::make_unique<ThreadData>(); // 值初始化，全部清零
+        data = p.get();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry().push_back(std::move(p));
+    }
+    return *data;
+}
+
+// 单写者递增：读-改-写不需要原子指令，读者最多看到稍旧的值
+inline void bump(std::atomic<uint64_t>& a, uint64_t n) {
+    a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+int bucketOf(uint64_t ns) {
+    if (ns < Metrics::SUB_BUCKETS) return (int)ns;
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long top;
+    _BitScanReverse64(&top, ns);
+    int e = (int)top;
+#else
+    int e = 63 - __builtin_clzll(ns);
+#endif
+    int sub = (int)((ns >> (e - 2)) & (Metrics::SUB_BUCKETS - 1));
+    return e * Metrics::SUB_BUCKETS + sub;
+}
+
+uint64_t bucketUpper(int b) {
+    if (b < Metrics::SUB_BUCKETS) return (uint64_t)b;
+    int e = b / Metrics::SUB_BUCKETS, sub = b % Metrics::SUB_BUCKETS;
+    return ((uint64_t)(Metrics::SUB_BUCKETS + sub + 1) << (e - 2)) - 1;
+}
+
+std::mutex dumpMutex;
+std::condition_variable dumpCv;
+std::thread dumpThread;
+bool dumpStop = false;
+
+} // namespace
+
+const char* Metrics::name(Metric m) {
+    switch (m) {
+    case Metric::COMMAND: return "command";
+    case Metric::MOVE_GOMOKU: return "move.gomoku";
+    case Metric::MOVE_GO: return "move.go";
+    case Metric::MOVE_VALIDATE: return "move.validate";
+    case Metric::MOVE_HISTORY: return "move.history";
+    case Metric::MOVE_POST: return "move.post";
+    case Metric::MOVE_CHECKWIN: return "move.checkwin";
+    case Metric::MOVE_NOTIFY: return "move.notify";
+    case Metric::RENDER: return "render";
+    default: return "?";
+    }
+}
+
+const char* Metrics::name(Counter c) {
+    switch (c) {
+    case Counter::MOVE_REJECTED: return "move.rejected";
+    case Counter::COMMAND_ERROR: return "command.error";
+    default: return "?";
+    }
+}
+
+void Metrics::record(Metric m, uint64_t ns) {
+    ThreadData::Histogram& h = local().hist[(int)m];
+    bump(h.count, 1);
+    bump(h.sumNs, ns);
+    if (ns > h.maxNs.load(std::memory_order_relaxed)) h.maxNs.store(ns, std::memory_order_relaxed);
+    bump(h.buckets[bucketOf(ns)], 1);
+}
+
+void Metrics::add(Counter c, uint64_t n) {
+    bump(local().counters[(int)c], n);
+}
+
+uint64_t Metrics::Summary::percentileNs(double p) const {
+    if (count == 0) return 0;
+    // 最近秩：第 ceil(p * count) 个样本
+    uint64_t rank = (uint64_t)std::ceil(p * (double)count);
+    if (rank < 1) rank = 1;
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += buckets[b];
+        if (seen >= rank) return bucketUpper(b) < maxNs ? bucketUpper(b) : maxNs;
+    }
+    return maxNs;
+}
+
+Metrics::Summary Metrics::summarize(Metric m) {
+    Summary s;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto& t : registry()) {
+        const ThreadData::Histogram& h = t->hist[(int)m];
+        s.count += h.count.load(std::memory_order_relaxed);
+        s.sumNs += h.sumNs.load(std::memory_order_relaxed);
+        uint64_t mx = h.maxNs.load(std::memory_order_relaxed);
+        if (mx > s.maxNs) s.maxNs = mx;
+        for (int b = 0; b < BUCKETS; ++b) s.buckets[b] += h.buckets[b].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+uint64_t Metrics::total(Counter c) {
+    uint64_t n = 0;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto& t : registry()) n += t->counters[(int)c].load(std::memory_order_relaxed);
+    return n;
+}
+
+// 与写入线程并发时，正在进行的那一次记录可能残留在清零后的数据里
+void Metrics::reset() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto& t : registry()) {
+        for (auto& h : t->hist) {
+            h.count.store(0, std::memory_order_relaxed);
+            h.sumNs.store(0, std::memory_order_relaxed);
+            h.maxNs.store(0, std::memory_order_relaxed);
+            for (auto& b : h.buckets) b.store(0, std::memory_order_relaxed);
+        }
+        for (auto& c : t->counters) c.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::string Metrics::report() {
+    if (!enabled()) return "性能统计未启用（编译时未定义 CHESS_METRICS）";
+
+    std::string out = "性能统计（微秒）\n";
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-14s %10s %10s %10s %10s %10s\n", "item", "count", "mean", "p50", "p99", "max");
+    out += line;
+    for (int i = 0; i < METRIC_COUNT_; ++i) {
+        Summary s = summarize((Metric)i);
+        if (s.count == 0) continue;
+        std::snprintf(line, sizeof(line), "%-14s %10llu %10.2f %10.2f %10.2f %10.2f\n", name((Metric)i),
+                      (unsigned long long)s.count, s.meanNs() / 1000.0, s.percentileNs(0.5) / 1000.0,
+                      s.percentileNs(0.99) / 1000.0, s.maxNs / 1000.0);
+        out += line;
+    }
+    for (int i = 0; i < COUNTER_COUNT_; ++i) {
+        std::snprintf(line, sizeof(line), "%-14s %10llu\n", name((Counter)i), (unsigned long long)total((Counter)i));
+        out += line;
+    }
+    out.pop_back();
+    return out;
+}
+
+void Metrics::startDump(const std::string& path, int intervalMs) {
+    stopDump();
+    if (intervalMs <= 0) intervalMs = 1000;
+    dumpStop = false;
+    dumpThread = std::thread([path, intervalMs]() {
+        std::unique_lock<std::mutex> lock(dumpMutex);
+        while (!dumpStop) {
+            dumpCv.wait_for(lock, std::chrono::milliseconds(intervalMs), [] { return dumpStop; });
+            std::string tmp = path + ".tmp";
+            {
+                std::ofstream ofs(tmp, std::ios::trunc);
+                if (!ofs) continue;
+                ofs << report() << "\n";
+            }
+            std::rename(tmp.c_str(), path.c_str());
+        }
+    });
+}
+
+void Metrics::stopDump() {
+    if (!dumpThread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(dumpMutex);
+        dumpStop = true;
+    }
+    dumpCv.notify_all();
+    dumpThread.join();
+}
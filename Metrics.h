@@ -0,0 +1,105 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// 性能统计：热路径上的分段计时与计数
+// 编译时定义 CHESS_METRICS 才会启用（CMake 选项 CHESS_METRICS，默认打开）；未定义时 METRIC_* 宏展开为空，不产生任何代码
+// 每个线程写自己的一份直方图（单写者，只用 relaxed 原子读写，无锁前缀指令），汇总时各线程的数据相加
+// 直方图按纳秒分桶：每个 2 的幂区间再均分 4 段，相对误差不超过 25%
+
+// 计时项
+enum class Metric {
+    COMMAND,        // 会话处理一行指令
+    MOVE_GOMOKU,    // 五子棋一次落子（tryMove 全程）
+    MOVE_GO,        // 围棋一次落子
+    MOVE_VALIDATE,  // 落子合法性检查（isValid + preMoveCheck）
+    MOVE_HISTORY,   // saveStateToHistory
+    MOVE_POST,      // postMoveProcess（围棋提子）
+    MOVE_CHECKWIN,  // 胜负判定
+    MOVE_NOTIFY,    // 通知观察者
+    RENDER,         // ConsoleUI::render
+    COUNT
+};
+
+// 计数项
+enum class Counter {
+    MOVE_REJECTED, // 不合法而被拒绝的落子
+    COMMAND_ERROR, // 返回错误的指令
+    COUNT
+};
+
+class Metrics {
+public:
+    static constexpr int SUB_BUCKETS = 4;
+    static constexpr int BUCKETS = 64 * SUB_BUCKETS;
+
+    // 汇总结果（各线程相加后的普通数值）
+    struct Summary {
+        uint64_t count = 0;
+        uint64_t sumNs = 0;
+        uint64_t maxNs = 0;
+        uint64_t buckets[BUCKETS] = {};
+
+        double meanNs() const { return count ? (double)sumNs / count : 0; }
+        // 第 p 分位（0~1），取所在桶的上界
+        uint64_t percentileNs(double p) const;
+    };
+
+    static const char* name(Metric m);
+    static const char* name(Counter c);
+
+    static void record(Metric m, uint64_t ns);
+    static void add(Counter c, uint64_t n = 1);
+
+    static Summary summarize(Metric m);
+    static uint64_t total(Counter c);
+    static void reset();
+
+    // 文本报表：每项的次数、平均、p50、p99、最大值（微秒）
+    static std::string report();
+
+    // 后台线程每隔 intervalMs 把报表写入 path（先写临时文件再改名，读者不会看到半份）
+    static void startDump(const std::string& path, int intervalMs);
+    static void stopDump();
+
+    static constexpr bool enabled() {
+#ifdef CHESS_METRICS
+        return true;
+#else
+        return false;
+#endif
+    }
+};
+
+// 作用域计时：构造时取时刻，析构时记入直方图
+class ScopedTimer {
+private:
+    Metric metric;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(Metric m) : metric(m), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        Metrics::record(metric, (uint64_t)ns);
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+#define METRIC_CONCAT2(a, b) a##b
+#define METRIC_CONCAT(a, b) METRIC_CONCAT2(a, b)
+
+#ifdef CHESS_METRICS
+#define METRIC_SCOPE(m) ScopedTimer METRIC_CONCAT(metricTimer_, __LINE__)(m)
+#define METRIC_COUNT(c) Metrics::add(c)
+#else
+#define METRIC_SCOPE(m) ((void)0)
+#define METRIC_COUNT(c) ((void)0)
+#endif
+
+#endif // METRICS_H
@@ -1,14 +1,26 @@
 #ifndef OBSERVER_H
 #define OBSERVER_H
 
-#include <vector>
 #include <string>
 #include "GameTypes.h"
+#include "Board.h"
 
-// ۲߽ӿ
+// 一个格子的变化：坐标与变化后的取值（Board::EMPTY/BLACK/WHITE）
+struct CellChange {
+    int x, y;
+    uint8_t value;
+};
+
+// 观察者接口
 class IGameObserver {
 public:
-    virtual void onBoardUpdate(const std::vector<std::vector<int>>& board, int size) = 0;
+    // 整盘通知：开局、读档、刷新时发送，供新加入的观察者同步完整局面
+    virtual void onBoardUpdate(const Board& board) = 0;
+    // 增量通知：落子/悔棋后只列出变化的格子（落下的子与被提的子）
+    // 默认退化为整盘通知，只关心整盘的观察者不必实现
+    virtual void onCellsChanged(const Board& board, const CellChange* changes, int count) {
+        onBoardUpdate(board);
+    }
     virtual void onMessage(const std::string& msg) = 0;
     virtual void onGameOver(PieceColor winner) = 0;
     virtual ~IGameObserver() = default;
@@ -0,0 +1,254 @@
+#include "OpeningBook.h"
+#include "AbstractGame.h"
+#include "GameFactory.h"
+#include "GameMemento.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <fstream>
+
+namespace {
+
+uint64_t load64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+uint32_t load32(const uint8_t* p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+uint16_t load16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+void store64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+void store32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+void store16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)(v >> 8);
+}
+
+// 棋类与尺寸的盐值，使不同棋类、不同尺寸的局面可以放在同一个库里
+uint64_t gameSalt(GameType type, int size) {
+    uint64_t z = ((uint64_t)(type == GameType::GO ? 1 : 0) << 8 | (uint64_t)size) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+// 映射文件并检查文件头
+OpeningBook::OpeningBook(const std::string& path) : file(path) {
+    const uint8_t* p = file.getData();
+    size_t len = file.getLength();
+    if (len < HEADER_SIZE || p[0] != 'C' || p[1] != 'B' || p[2] != 'K') throw GameException("开局库格式错误");
+    if (p[3] != VERSION) throw GameException("不支持的开局库版本");
+
+    capacity = load64(p + 8);
+    count = load64(p + 16);
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0 || count >= capacity) throw GameException("开局库格式错误");
+    if ((len - HEADER_SIZE) / SLOT_SIZE < capacity) throw GameException("开局库数据不完整");
+    slots = p + HEADER_SIZE;
+}
+
+void OpeningBook::transform(int t, int size, int x, int y, int& ox, int& oy) {
+    int n = size - 1;
+    int a = (t & 1) ? n - x : x;
+    int b = (t & 2) ? n - y : y;
+    if (t & 4) std::swap(a, b);
+    ox = a;
+    oy = b;
+}
+
+void OpeningBook::inverseTransform(int t, int size, int x, int y, int& ox, int& oy) {
+    int n = size - 1;
+    if (t & 4) std::swap(x, y);
+    ox = (t & 1) ? n - x : x;
+    oy = (t & 2) ? n - y : y;
+}
+
+// 一次扫描棋盘，每颗棋子同时累加到 8 个变换的哈希里；取最小值，相等时取编号小的变换
+OpeningBook::CanonicalKey OpeningBook::canonicalKey(const Board& board, GameType type, PieceColor toMove) {
+    int size = board.getSize();
+    uint64_t h[8] = {};
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            uint8_t v = board.at(Board::index(i, j));
+            if (v != Board::BLACK && v != Board::WHITE) continue;
+            for (int t = 0; t < 8; ++t) {
+                int x, y;
+                transform(t, size, i, j, x, y);
+                h[t] ^= Zobrist::piece(Board::index(x, y), v);
+            }
+        }
+    }
+    int best = 0;
+    for (int t = 1; t < 8; ++t) {
+        if (h[t] < h[best]) best = t;
+    }
+    uint64_t key = h[best] ^ gameSalt(type, size) ^ (toMove == PieceColor::WHITE ? Zobrist::side() : 0);
+    if (key == 0) key = 1; // 0 表示空槽
+    return {key, best};
+}
+
+bool OpeningBook::probe(const Board& board, GameType type, PieceColor toMove, BookMove& out) const {
+    CanonicalKey ck = canonicalKey(board, type, toMove);
+    uint64_t mask = capacity - 1;
+    // 最多探测一整圈：文件头的条目数不可信，损坏的库可能没有空槽
+    for (uint64_t n = 0, i = ck.key & mask; n < capacity; ++n, i = (i + 1) & mask) {
+        const uint8_t* slot = slots + i * SLOT_SIZE;
+        uint64_t key = load64(slot);
+        if (key == 0) return false;
+        if (key != ck.key) continue;
+
+        int size = board.getSize();
+        uint16_t move = load16(slot + 12);
+        out.games = load32(slot + 8);
+        out.winRate = load16(slot + 14) / 10000.0;
+        out.pass = (move == PASS_MOVE);
+        if (out.pass) {
+            out.x = out.y = -1;
+        } else {
+            if (move >= size * size) return false;
+            inverseTransform(ck.transform, size, move / size, move % size, out.x, out.y);
+        }
+        return true;
+    }
+    return false;
+}
+
+bool OpeningBook::probe(const AbstractGame& game, BookMove& out) const {
+    return probe(game.getBoard(), game.getType(), game.getCurrentPlayer(), out);
+}
+
+// 重放一局：先记下前 maxPly 步的（规范局面键, 规范着法, 行棋方），终局后再按胜负累加
+bool OpeningBookBuilder::replay(GameType type, int size, const Board& initial, PieceColor first,
+                                const std::vector<int>& moves, const Board* expectFinal) {
+    struct Ply {
+        uint64_t key;
+        uint16_t move;
+        PieceColor player;
+    };
+
+    std::shared_ptr<IGameFactory> factory;
+    if (type == GameType::GO) factory = std::make_shared<GoFactory>();
+    else factory = std::make_shared<GomokuFactory>();
+    auto game = factory->createGame(size);
+    game->restoreMemento(std::make_shared<GameMemento>(initial, first, size, type, 0));
+
+    std::vector<Ply> plies;
+    plies.reserve(std::min((size_t)maxPly, moves.size()));
+    try {
+        for (size_t k = 0; k < moves.size(); ++k) {
+            int m = moves[k];
+            if ((int)k < maxPly) {
+                OpeningBook::CanonicalKey ck = OpeningBook::canonicalKey(game->getBoard(), type, game->getCurrentPlayer());
+                uint16_t cm = OpeningBook::PASS_MOVE;
+                if (m >= 0) {
+                    int x, y;
+                    OpeningBook::transform(ck.transform, size, m / size, m % size, x, y);
+                    cm = (uint16_t)(x * size + y);
+                }
+                plies.push_back({ck.key, cm, game->getCurrentPlayer()});
+            }
+            if (m < 0) game->passTurn();
+            else game->makeMove(m / size, m % size);
+        }
+    } catch (const GameException&) {
+        return false;
+    }
+    if (expectFinal && game->getBoard() != *expectFinal) return false;
+
+    PieceColor winner = game->isOver() ? game->getWinner() : PieceColor::NONE;
+    for (const Ply& p : plies) {
+        MoveStats& s = positions[p.key][p.move];
+        s.games++;
+        s.points += (winner == PieceColor::NONE) ? 1 : (winner == p.player ? 2 : 0);
+    }
+    gamesAdded++;
+    return true;
+}
+
+bool OpeningBookBuilder::addGame(const AbstractGame& game) {
+    const auto& history = game.getHistory();
+    int size = game.getSize();
+    std::vector<int> moves;
+    moves.reserve(history.size());
+    for (const auto& rec : history) {
+        moves.push_back(rec.idx < 0 ? -1 : Board::rowOf(rec.idx) * size + Board::colOf(rec.idx));
+    }
+    PieceColor first = history.empty() ? game.getCurrentPlayer() : history.front().player;
+    return replay(game.getType(), size, game.getInitialBoard(), first, moves, nullptr);
+}
+
+bool OpeningBookBuilder::addRecord(const GameRecordView& rec) {
+    std::shared_ptr<GameMemento> mem = GameMemento::fromRecord(rec);
+    const std::vector<int>& moves = mem->getMoves();
+    if (moves.empty()) return false;
+
+    // 记录里没有先手信息：按黑先假定，轮次与记录的当前玩家对不上时改为白先
+    PieceColor first = PieceColor::BLACK;
+    PieceColor other = PieceColor::WHITE;
+    if ((moves.size() % 2 == 0) != (rec.currentPlayer == first)) std::swap(first, other);
+
+    Board finalBoard(rec.boardSize);
+    for (int i = 0; i < rec.boardSize; ++i) {
+        for (int j = 0; j < rec.boardSize; ++j) finalBoard.set(i, j, rec.cell(i, j));
+    }
+    return replay(rec.type, rec.boardSize, Board(rec.boardSize), first, moves, &finalBoard);
+}
+
+size_t OpeningBookBuilder::write(const std::string& path, uint32_t minGames) const {
+    struct Entry {
+        uint64_t key;
+        uint16_t move;
+        const MoveStats* stats;
+    };
+
+    std::vector<Entry> entries;
+    entries.reserve(positions.size());
+    for (const auto& pos : positions) {
+        const MoveStats* best = nullptr;
+        uint16_t bestMove = 0;
+        for (const auto& mv : pos.second) {
+            const MoveStats& s = mv.second;
+            // 比较 points/games 不做除法：a/b > c/d 等价于 a*d > c*b
+            if (!best || s.games > best->games ||
+                (s.games == best->games && (uint64_t)s.points * best->games > (uint64_t)best->points * s.games) ||
+                (s.games == best->games && (uint64_t)s.points * best->games == (uint64_t)best->points * s.games && mv.first < bestMove)) {
+                best = &s;
+                bestMove = mv.first;
+            }
+        }
+        if (best && best->games >= minGames) entries.push_back({pos.first, bestMove, best});
+    }
+
+    uint64_t capacity = 16;
+    while (capacity < entries.size() * 2) capacity <<= 1;
+
+    std::vector<uint8_t> out(OpeningBook::HEADER_SIZE + capacity * OpeningBook::SLOT_SIZE, 0);
+    out[0] = 'C'; out[1] = 'B'; out[2] = 'K';
+    out[3] = OpeningBook::VERSION;
+    store64(&out[8], capacity);
+    store64(&out[16], entries.size());
+
+    uint8_t* slots = &out[OpeningBook::HEADER_SIZE];
+    for (const Entry& e : entries) {
+        uint64_t i = e.key & (capacity - 1);
+        while (load64(slots + i * OpeningBook::SLOT_SIZE) != 0) i = (i + 1) & (capacity - 1);
+        uint8_t* slot = slots + i * OpeningBook::SLOT_SIZE;
+        store64(slot, e.key);
+        store32(slot + 8, e.stats->games);
+        store16(slot + 12, e.move);
+        store16(slot + 14, (uint16_t)((uint64_t)e.stats->points * 5000 / e.stats->games));
+    }
+
+    std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+    if (!ofs) throw GameException("文件创建失败");
+    ofs.write(reinterpret_cast<const char*>(out.data()), (std::streamsize)out.size());
+    if (!ofs) throw GameException("文件写入失败");
+    return entries.size();
+}
@@ -0,0 +1,100 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include "GameTypes.h"
+#include "Board.h"
+#include "MappedFile.h"
+
+class AbstractGame;
+struct GameRecordView;
+
+// 开局库：按“对称规范化”的局面键存放最佳着法与胜率
+// 局面键 = 8 种旋转/翻转下棋子 Zobrist 哈希的最小值，再异或行棋方与棋类/尺寸，互为对称的局面共用一个条目
+// 着法按取到最小值的那个变换存成规范方向，查询时用同一局面的变换逆回实际坐标
+// 不区分围棋的劫争状态；取到的着法须再经 tryMove 检查，不合法时按未命中处理
+//
+// 文件格式（版本 1，多字节字段均为小端）：
+//   [0..2] 魔数 "CBK"  [3] 版本  [4..7] 保留  [8..15] 表容量（2 的幂）  [16..23] 条目数  [24..31] 保留
+//   随后为容量个 16 字节的槽：[0..7] 局面键（0 为空槽）  [8..11] 对局数  [12..13] 规范着法 x*size+y，停一手为 0xFFFF  [14..15] 胜率 x10000
+// 开放寻址、线性探测，装载率不超过 1/2：整个文件映射到内存，打开即用，一次查询只读一两个槽
+class OpeningBook {
+public:
+    static constexpr uint8_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 32;
+    static constexpr size_t SLOT_SIZE = 16;
+    static constexpr uint16_t PASS_MOVE = 0xFFFF;
+
+    // 查询结果（已换回实际方向）
+    struct BookMove {
+        int x = -1, y = -1;
+        bool pass = false;
+        uint32_t games = 0;   // 该局面下此着出现的对局数
+        double winRate = 0;   // 行棋方以此着的胜率（和棋与未终局记半胜）
+    };
+
+    // 规范化的局面键及取到它的变换编号
+    struct CanonicalKey {
+        uint64_t key;
+        int transform;
+    };
+
+private:
+    MappedFile file;
+    const uint8_t* slots = nullptr;
+    uint64_t capacity = 0;
+    uint64_t count = 0;
+
+public:
+    explicit OpeningBook(const std::string& path); // 文件格式不对时抛出 GameException
+
+    // O(1) 查询：局面不在库中返回 false
+    bool probe(const Board& board, GameType type, PieceColor toMove, BookMove& out) const;
+    bool probe(const AbstractGame& game, BookMove& out) const;
+
+    size_t size() const { return (size_t)count; }
+
+    // 变换 t（0~7）：第 0 位上下翻转，第 1 位左右翻转，第 2 位沿主对角线转置（最后做）
+    static void transform(int t, int size, int x, int y, int& ox, int& oy);
+    static void inverseTransform(int t, int size, int x, int y, int& ox, int& oy);
+
+    static CanonicalKey canonicalKey(const Board& board, GameType type, PieceColor toMove);
+};
+
+// 离线建库：重放对局语料，统计每个开局局面下各着法的次数与胜负
+class OpeningBookBuilder {
+private:
+    struct MoveStats {
+        uint32_t games = 0;
+        uint32_t points = 0; // 胜 2、和或未终局 1、负 0
+    };
+
+    int maxPly;
+    size_t gamesAdded = 0;
+    std::unordered_map<uint64_t, std::unordered_map<uint16_t, MoveStats>> positions;
+
+    // 从起始局面重放着法（x*size+y，停一手为 -1），只统计前 maxPly 步
+    // expectFinal 非空时重放结果须与之一致，否则整局不计入；着法不合法同样不计入
+    bool replay(GameType type, int size, const Board& initial, PieceColor first, const std::vector<int>& moves,
+                const Board* expectFinal);
+
+public:
+    explicit OpeningBookBuilder(int plies = 20) : maxPly(plies) {}
+
+    // 加入一局（如 SGF 读入的对局），从其记录起点重放
+    bool addGame(const AbstractGame& game);
+    // 加入一条二进制存档记录：记录只含终局棋盘与着法，从空盘重放能还原终局时才计入
+    bool addRecord(const GameRecordView& rec);
+
+    size_t getGamesAdded() const { return gamesAdded; }
+    size_t getPositionCount() const { return positions.size(); }
+
+    // 每个局面保留出现次数最多的着法（同次数取胜率高者），对局数少于 minGames 的不写入；返回写入的条目数
+    size_t write(const std::string& path, uint32_t minGames = 1) const;
+};
+
+#endif // OPENINGBOOK_H
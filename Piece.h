@@ -4,7 +4,7 @@
 #include <memory>
 #include "GameTypes.h"
 
-// ӽӿ
+// 抽象棋子接口
 class Piece {
 public:
     virtual PieceColor getColor() const = 0;
@@ -12,21 +12,21 @@ public:
     virtual ~Piece() = default;
 };
 
-// ӣ
+// 具体棋子：黑棋
 class BlackPiece : public Piece {
 public:
     PieceColor getColor() const override { return PieceColor::BLACK; }
-    std::string getSymbol() const override { return ""; } 
+    std::string getSymbol() const override { return "回"; } 
 };
 
-// ӣ
+// 具体棋子：白棋
 class WhitePiece : public Piece {
 public:
     PieceColor getColor() const override { return PieceColor::WHITE; }
-    std::string getSymbol() const override { return ""; } 
+    std::string getSymbol() const override { return "口"; } 
 };
 
-// ԪʵȷȫֻӶ
+// 享元工厂：管理棋子实例，确保全局只有两个棋子对象
 class PieceFactory {
 public:
     static std::shared_ptr<Piece> getPiece(PieceColor color) {
@@ -0,0 +1,263 @@
+#include "ReplayVerifier.h"
+#include "GameFactory.h"
+#include "GameMemento.h"
+#include "GoStrategy.h"
+#include "GomokuStrategy.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+std::string VerifySummary::toString() const {
+    std::stringstream ss;
+    ss << "games=" << games << " moves=" << moves << " failures=" << failures.size() << " threads=" << threads
+       << " elapsed_ms=" << (long)elapsedMs << " games_per_sec=" << gamesPerSec()
+       << " moves_per_sec=" << movesPerSec();
+    return ss.str();
+}
+
+namespace {
+
+// 切分出的一条记录：指向映射区域的文本范围
+struct RecordRef {
+    int file;
+    int line;
+    const char* begin;
+    const char* end;
+};
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+// 取 [p, end) 中下一个空白分隔的词，没有时返回空
+std::string_view nextToken(const char*& p, const char* end) {
+    while (p < end && isSpace(*p)) ++p;
+    const char* start = p;
+    while (p < end && !isSpace(*p)) ++p;
+    return std::string_view(start, p - start);
+}
+
+bool parseInt(std::string_view s, int& out) {
+    if (s.empty()) return false;
+    auto res = std::from_chars(s.data(), s.data() + s.size(), out);
+    return res.ec == std::errc() && res.ptr == s.data() + s.size();
+}
+
+bool parseColor(std::string_view s, PieceColor& out) {
+    if (s == "BLACK") out = PieceColor::BLACK;
+    else if (s == "WHITE") out = PieceColor::WHITE;
+    else if (s == "NONE") out = PieceColor::NONE;
+    else return false;
+    return true;
+}
+
+// 单线程扫描一遍文本，只按行切分记录，不解析内容（内容错误留给校验线程报告）
+void splitRecords(int file, const char* data, size_t length, std::vector<RecordRef>& out) {
+    const char* p = data;
+    const char* end = data + length;
+    int line = 0;
+    auto nextLine = [&](const char*& lineBegin, const char*& lineEnd) {
+        lineBegin = p;
+        while (p < end && *p != '\n') ++p;
+        lineEnd = p;
+        if (p < end) ++p;
+        ++line;
+    };
+
+    while (p < end) {
+        const char *b, *e;
+        nextLine(b, e);
+        const char* q = b;
+        std::string_view first = nextToken(q, e);
+        if (first.empty() || first[0] == '#') continue;
+
+        RecordRef rec = {file, line, b, e};
+        std::string_view sizeTok = nextToken(q, e);
+        std::string_view third = nextToken(q, e);
+        int size = 0, pass = 0;
+        if (parseInt(third, pass) && parseInt(sizeTok, size) && size >= 1 && size <= Board::MAX_SIZE) {
+            // 备忘录：首行之后还有 size 行棋盘与一行结果和着法
+            for (int k = 0; k <= size && p < end; ++k) nextLine(b, rec.end);
+        }
+        out.push_back(rec);
+    }
+}
+
+// 工作窃取的任务队列：每个线程一个双端队列，自己从尾部取，空了再从其他线程的头部偷
+struct TaskQueue {
+    std::mutex mutex;
+    std::deque<std::pair<size_t, size_t>> chunks; // 记录下标范围 [first, second)
+};
+
+bool takeTask(std::vector<TaskQueue>& queues, int self, std::pair<size_t, size_t>& task) {
+    {
+        TaskQueue& own = queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.chunks.empty()) {
+            task = own.chunks.back();
+            own.chunks.pop_back();
+            return true;
+        }
+    }
+    int n = (int)queues.size();
+    for (int i = 1; i < n; ++i) {
+        TaskQueue& victim = queues[(self + i) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.chunks.empty()) {
+            task = victim.chunks.front();
+            victim.chunks.pop_front();
+            return true;
+        }
+    }
+    return false; // 任务都是预先分好的，所有队列都空即全部完成
+}
+
+// 每个线程一份：工厂、胜负策略与内存区都在线程内复用
+class RecordChecker {
+private:
+    GameArena arena;
+    GomokuFactory gomokuFactory;
+    GoFactory goFactory;
+    GomokuWinStrategy gomokuWin;
+    GoWinStrategy goWin;
+
+public:
+    long moves = 0;
+
+    // 校验一条记录，通过返回空串，否则返回原因
+    std::string check(const RecordRef& rec) {
+        const char* p = rec.begin;
+        const char* end = rec.end;
+
+        std::string_view typeTok = nextToken(p, end);
+        GameType type;
+        if (typeTok == "GO") type = GameType::GO;
+        else if (typeTok == "GOMOKU") type = GameType::GOMOKU;
+        else return "格式错误: 未知的棋类";
+
+        int size = 0;
+        if (!parseInt(nextToken(p, end), size) || size < 1 || size > Board::MAX_SIZE) return "格式错误: 棋盘尺寸";
+
+        std::string_view third = nextToken(p, end);
+        std::shared_ptr<GameMemento> start;
+        int pass = 0;
+        if (parseInt(third, pass)) {
+            // 备忘录：当前玩家与棋盘，然后才是结果
+            PieceColor player;
+            if (!parseColor(nextToken(p, end), player)) return "格式错误: 当前玩家";
+            // 与 GameMemento 读档同一套范围检查，读档会拒绝的记录这里同样不通过
+            if (!isValidMementoHeader(size, pass, player)) return "格式错误: 存档头超出范围";
+            Board board(size);
+            for (int i = 0; i < size; ++i) {
+                for (int j = 0; j < size; ++j) {
+                    int v;
+                    if (!parseInt(nextToken(p, end), v) || v < 0 || v > 2) return "格式错误: 棋盘数据";
+                    board.set(i, j, (uint8_t)v);
+                }
+            }
+            start = std::make_shared<GameMemento>(board, player, size, type, pass);
+            third = nextToken(p, end);
+        }
+        PieceColor recorded;
+        if (!parseColor(third, recorded)) return "格式错误: 结果须为 BLACK、WHITE 或 NONE";
+
+        // 上一局的对象已在上次返回时销毁，内存区可以整体收回
+        arena.reset();
+        IGameFactory& factory = (type == GameType::GO) ? static_cast<IGameFactory&>(goFactory) : static_cast<IGameFactory&>(gomokuFactory);
+        std::shared_ptr<AbstractGame> game = factory.createGame(size, &arena);
+        if (start) game->restoreMemento(start);
+
+        int ply = 0;
+        for (std::string_view tok = nextToken(p, end); !tok.empty(); tok = nextToken(p, end)) {
+            ++ply;
+            AbstractGame::UndoInfo u;
+            if (tok == "pass") {
+                u = game->playPass();
+            } else {
+                size_t comma = tok.find(',');
+                int r = 0, c = 0;
+                if (comma == std::string_view::npos || !parseInt(tok.substr(0, comma), r) || !parseInt(tok.substr(comma + 1), c)) {
+                    return "第 " + std::to_string(ply) + " 手: 格式错误 " + std::string(tok);
+                }
+                u = game->play(r - 1, c - 1);
+            }
+            if (u.status != MoveStatus::OK) {
+                return "第 " + std::to_string(ply) + " 手 " + std::string(tok) + " 不合法: " + moveStatusText(u.status);
+            }
+            moves++;
+        }
+
+        PieceColor actual = (type == GameType::GO) ? goWin.checkWin(game->getBoard(), true) : gomokuWin.checkWin(game->getBoard());
+        if (actual != recorded) return "结果不符: 记录为 " + colorToString(recorded) + "，判定为 " + colorToString(actual);
+        return std::string();
+    }
+};
+
+} // namespace
+
+VerifySummary ReplayVerifier::run(const std::vector<std::string>& paths) {
+    int threads = config.threads;
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    size_t chunkSize = std::max<size_t>(1, config.chunkSize);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // 整个文件映射到内存，记录只保存指向映射区域的范围
+    std::vector<std::unique_ptr<MappedFile>> files;
+    std::vector<RecordRef> records;
+    for (size_t f = 0; f < paths.size(); ++f) {
+        files.emplace_back(new MappedFile(paths[f]));
+        splitRecords((int)f, reinterpret_cast<const char*>(files.back()->getData()), files.back()->getLength(), records);
+    }
+
+    // 按块均分给各线程，每个线程拿到连续的一段
+    size_t chunkCount = (records.size() + chunkSize - 1) / chunkSize;
+    std::vector<TaskQueue> queues(threads);
+    for (size_t c = 0; c < chunkCount; ++c) {
+        size_t first = c * chunkSize;
+        queues[c * threads / chunkCount].chunks.push_back({first, std::min(records.size(), first + chunkSize)});
+    }
+
+    std::vector<long> movesPerThread(threads, 0);
+    std::vector<std::vector<std::pair<size_t, std::string>>> failuresPerThread(threads);
+    auto work = [&](int t) {
+        RecordChecker checker;
+        std::pair<size_t, size_t> task;
+        while (takeTask(queues, t, task)) {
+            for (size_t i = task.first; i < task.second; ++i) {
+                std::string reason = checker.check(records[i]);
+                if (!reason.empty()) failuresPerThread[t].push_back({i, std::move(reason)});
+            }
+        }
+        movesPerThread[t] = checker.moves;
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(work, t);
+    work(0);
+    for (auto& th : pool) th.join();
+
+    VerifySummary summary;
+    summary.games = (long)records.size();
+    summary.threads = threads;
+    std::vector<std::pair<size_t, std::string>> failed;
+    for (int t = 0; t < threads; ++t) {
+        summary.moves += movesPerThread[t];
+        for (auto& f : failuresPerThread[t]) failed.push_back(std::move(f));
+    }
+    // 记录下标即文件内的先后顺序
+    std::sort(failed.begin(), failed.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (auto& f : failed) {
+        const RecordRef& rec = records[f.first];
+        summary.failures.push_back({paths[rec.file], rec.line, std::move(f.second)});
+    }
+    summary.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
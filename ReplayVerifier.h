@@ -0,0 +1,55 @@
+#ifndef REPLAYVERIFIER_H
+#define REPLAYVERIFIER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "GameTypes.h"
+
+// 对局记录文本格式（一个文件可含多条记录，空行与 # 开头的行忽略）：
+//   着法表：一行  <GOMOKU|GO> <尺寸> <结果> <着法>...
+//           从空盘黑先开始；结果为 BLACK / WHITE / NONE；着法为 1 起的 "行,列" 或 pass
+//   备忘录：GameMemento::serialize 的文本（首行 <类型> <尺寸> <停手计数> <当前玩家>，随后为棋盘各行），
+//           紧接一行  <结果> <着法>...  从备忘录的局面开始重放
+// 两种记录按首行第三项区分：整数为备忘录的停手计数，否则为着法表的结果
+//
+// 校验：每一手都须合法（用 play 重放，不挂观察者），终局后不得再有着法；
+// 重放后的终局棋盘交给胜负策略判定（五子棋为连五，未连五为 NONE；围棋按数子），须与记录的结果一致
+
+// 校验配置
+struct VerifyConfig {
+    int threads = 0;          // 0 表示使用全部硬件线程
+    size_t chunkSize = 64;    // 每个任务块包含的记录数，线程空闲时按块窃取
+};
+
+// 一条未通过校验的记录
+struct VerifyFailure {
+    std::string file;
+    int line;                 // 记录首行的行号（从 1 开始）
+    std::string reason;
+};
+
+// 校验统计
+struct VerifySummary {
+    long games = 0;
+    long moves = 0;
+    int threads = 0;
+    double elapsedMs = 0;
+    std::vector<VerifyFailure> failures; // 按文件、行号排序
+
+    double gamesPerSec() const { return elapsedMs > 0 ? games * 1000.0 / elapsedMs : 0; }
+    double movesPerSec() const { return elapsedMs > 0 ? moves * 1000.0 / elapsedMs : 0; }
+    std::string toString() const;
+};
+
+// 对局记录校验：把输入文件映射到内存，先切分出各条记录，再分块交给工作窃取线程池并行重放
+class ReplayVerifier {
+private:
+    VerifyConfig config;
+
+public:
+    explicit ReplayVerifier(const VerifyConfig& cfg) : config(cfg) {}
+    VerifySummary run(const std::vector<std::string>& paths);
+};
+
+#endif // REPLAYVERIFIER_H
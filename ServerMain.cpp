@@ -0,0 +1,84 @@
+/*
+ * 多会话对局服务器入口：每个连接一盘独立的对局，指令与控制台相同
+ * 用法: game_server [--unix path | --port N] [--threads N] [--allow-files] [--book file]
+ *                    [--search-threads N] [--max-search-ms ms] [--max-search-threads N]
+ *                    [--metrics-dump file] [--metrics-interval ms]
+ * 连接示例: nc -U chess.sock 或 nc 127.0.0.1 N
+ */
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "GameServer.h"
+#include "GameTypes.h"
+#include "Metrics.h"
+
+static GameServer* activeServer = nullptr;
+
+static void onSignal(int) {
+    if (activeServer) activeServer->stop();
+}
+
+int main(int argc, char* argv[]) {
+    ServerConfig config;
+    std::string metricsPath;
+    int metricsIntervalMs = 10000;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "缺少参数值: " << arg << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--unix") {
+            config.unixPath = value();
+        } else if (arg == "--port") {
+            config.port = std::atoi(value().c_str());
+        } else if (arg == "--threads") {
+            config.threads = std::atoi(value().c_str());
+        } else if (arg == "--allow-files") {
+            config.allowFiles = true;
+        } else if (arg == "--book") {
+            config.bookPath = value();
+        } else if (arg == "--search-threads") {
+            config.searchThreads = std::atoi(value().c_str());
+        } else if (arg == "--max-search-ms") {
+            config.maxSearchMs = std::atoi(value().c_str());
+        } else if (arg == "--max-search-threads") {
+            config.maxSearchThreads = std::atoi(value().c_str());
+        } else if (arg == "--metrics-dump") {
+            metricsPath = value();
+        } else if (arg == "--metrics-interval") {
+            metricsIntervalMs = std::atoi(value().c_str());
+        } else {
+            std::cerr << "未知参数: " << arg << "\n";
+            return 2;
+        }
+    }
+    if (config.unixPath.empty() && config.port <= 0) config.unixPath = "chess.sock";
+
+    try {
+        GameServer server(config);
+        activeServer = &server;
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        std::signal(SIGPIPE, SIG_IGN);
+
+        // 定期把性能统计写入文件，退出时再写最后一次
+        if (!metricsPath.empty()) Metrics::startDump(metricsPath, metricsIntervalMs);
+
+        std::cerr << "服务器已启动: " << (config.unixPath.empty() ? "127.0.0.1:" + std::to_string(config.port) : config.unixPath) << "\n";
+        server.run();
+        activeServer = nullptr;
+        Metrics::stopDump();
+    } catch (const GameException& e) {
+        Metrics::stopDump();
+        std::cerr << "错误: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
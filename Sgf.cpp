@@ -0,0 +1,251 @@
+#include "Sgf.h"
+#include "GameFactory.h"
+#include <fstream>
+
+// 从文件读取：映射整个文件，按需换页
+SgfReader::SgfReader(const std::string& path)
+    : file(new MappedFile(path)), data(reinterpret_cast<const char*>(file->getData())), length(file->getLength()) {}
+
+void SgfReader::skipSpace() {
+    while (pos < length && (data[pos] == ' ' || data[pos] == '\n' || data[pos] == '\r' || data[pos] == '\t')) pos++;
+}
+
+std::string_view SgfReader::readIdent() {
+    size_t start = pos;
+    while (pos < length && ((data[pos] >= 'A' && data[pos] <= 'Z') || (data[pos] >= 'a' && data[pos] <= 'z'))) pos++;
+    if (pos == start) throw GameException("SGF 格式错误：缺少属性名");
+    return std::string_view(data + start, pos - start);
+}
+
+// 读取一个 [值]，转义字符原样保留（只有着法与尺寸会被解析，它们不含转义）
+std::string_view SgfReader::readValue() {
+    pos++; // '['
+    size_t start = pos;
+    while (pos < length && data[pos] != ']') {
+        if (data[pos] == '\\') pos++;
+        pos++;
+    }
+    if (pos >= length) throw GameException("SGF 格式错误：属性值未结束");
+    std::string_view v(data + start, pos - start);
+    pos++; // ']'
+    return v;
+}
+
+// 跳过本局剩余部分（含所有变化）
+void SgfReader::skipToGameEnd() {
+    while (depth > 0 && pos < length) {
+        char c = data[pos];
+        if (c == '[') {
+            readValue();
+            continue;
+        }
+        if (c == '(') depth++;
+        else if (c == ')') depth--;
+        pos++;
+    }
+    depth = 0;
+}
+
+// 定位到下一局的 '('，忽略对局之间的其他文本
+bool SgfReader::seekGameStart() {
+    while (pos < length && data[pos] != '(') pos++;
+    if (pos >= length) return false;
+    pos++;
+    depth = 1;
+    return true;
+}
+
+namespace {
+
+// SGF 坐标 "cr"：第一个字母为列，第二个为行
+bool parsePoint(std::string_view v, int size, int& x, int& y) {
+    if (v.empty() || (v == "tt" && size <= 19)) return false; // 停一手
+    if (v.size() != 2) throw GameException("SGF 坐标格式错误");
+    y = v[0] - 'a';
+    x = v[1] - 'a';
+    if (x < 0 || x >= size || y < 0 || y >= size) throw GameException("SGF 坐标超出棋盘");
+    return true;
+}
+
+int parseInt(std::string_view v) {
+    int n = 0;
+    for (char c : v) {
+        if (c == ':') break; // SZ[列:行] 只取第一个值
+        if (c < '0' || c > '9') throw GameException("SGF 数值格式错误");
+        n = n * 10 + (c - '0');
+    }
+    return n;
+}
+
+} // namespace
+
+// 读取下一局并在新建的游戏上重放全部着法
+std::shared_ptr<AbstractGame> SgfReader::nextGame() {
+    if (!seekGameStart()) return nullptr;
+    gamesRead++;
+
+    try {
+        std::shared_ptr<AbstractGame> game;
+
+        // 依次访问当前节点的属性，直到遇到下一个节点或变化
+        auto eachProperty = [this](auto&& f) {
+            for (;;) {
+                skipSpace();
+                if (pos >= length) throw GameException("SGF 格式错误：对局不完整");
+                char c = data[pos];
+                if (c == ';' || c == '(' || c == ')') return;
+                std::string_view ident = readIdent();
+                skipSpace();
+                if (pos >= length || data[pos] != '[') throw GameException("SGF 格式错误：缺少属性值");
+                while (pos < length && data[pos] == '[') {
+                    f(ident, readValue());
+                    skipSpace();
+                }
+            }
+        };
+
+        auto playMove = [&game](std::string_view ident, std::string_view v) {
+            PieceColor color = (ident == "B") ? PieceColor::BLACK : PieceColor::WHITE;
+            if (game->getCurrentPlayer() != color) throw GameException("SGF 着法顺序与轮次不符");
+            int x, y;
+            if (parsePoint(v, game->getSize(), x, y)) game->makeMove(x, y);
+            else game->passTurn();
+        };
+
+        for (;;) {
+            skipSpace();
+            if (pos >= length) throw GameException("SGF 格式错误：对局不完整");
+            char c = data[pos++];
+
+            if (c == ';' && !game) {
+                // 根节点：先读取规则与尺寸，再回到节点开头处理摆子与着法，无需缓存属性
+                size_t nodeStart = pos;
+                GameType type = GameType::GO;
+                int size = 0;
+                PieceColor first = PieceColor::BLACK;
+                bool hasSetup = false;
+                eachProperty([&](std::string_view ident, std::string_view v) {
+                    if (ident == "GM") {
+                        int gm = parseInt(v);
+                        if (gm == 1) type = GameType::GO;
+                        else if (gm == 4) type = GameType::GOMOKU;
+                        else throw GameException("SGF 不支持的棋类");
+                    } else if (ident == "SZ") {
+                        size = parseInt(v);
+                    } else if (ident == "PL") {
+                        first = (v == "W") ? PieceColor::WHITE : PieceColor::BLACK;
+                    } else if (ident == "AB" || ident == "AW" || ident == "AE") {
+                        hasSetup = true;
+                    }
+                });
+                if (size == 0) size = (type == GameType::GO) ? 19 : 15;
+                if (size < 1 || size > Board::MAX_SIZE) throw GameException("SGF 棋盘尺寸超出支持范围");
+
+                std::shared_ptr<IGameFactory> factory;
+                if (type == GameType::GO) factory = std::make_shared<GoFactory>();
+                else factory = std::make_shared<GomokuFactory>();
+                game = factory->createGame(size);
+
+                pos = nodeStart;
+                if (hasSetup || first != PieceColor::BLACK) {
+                    Board setup(size);
+                    eachProperty([&](std::string_view ident, std::string_view v) {
+                        int x, y;
+                        if (ident == "AB" && parsePoint(v, size, x, y)) setup.set(x, y, Board::BLACK);
+                        else if (ident == "AW" && parsePoint(v, size, x, y)) setup.set(x, y, Board::WHITE);
+                        else if (ident == "AE" && parsePoint(v, size, x, y)) setup.set(x, y, Board::EMPTY);
+                    });
+                    game->restoreMemento(std::make_shared<GameMemento>(setup, first, size, type, 0));
+                    pos = nodeStart;
+                }
+                eachProperty([&](std::string_view ident, std::string_view v) {
+                    if (ident == "B" || ident == "W") playMove(ident, v);
+                });
+            } else if (c == ';') {
+                eachProperty([&](std::string_view ident, std::string_view v) {
+                    if (ident == "B" || ident == "W") playMove(ident, v);
+                });
+            } else if (c == '(') {
+                depth++; // 进入第一个变化，即主线
+            } else if (c == ')') {
+                depth--;
+                // 主线已结束，其余变化全部跳过
+                skipToGameEnd();
+                break;
+            } else {
+                throw GameException("SGF 格式错误");
+            }
+        }
+
+        if (!game) throw GameException("SGF 格式错误：空对局");
+        return game;
+    } catch (...) {
+        skipToGameEnd();
+        throw;
+    }
+}
+
+// 跳过下一局（不落子）
+bool SgfReader::skipGame() {
+    if (!seekGameStart()) return false;
+    gamesRead++;
+    skipToGameEnd();
+    return true;
+}
+
+namespace {
+
+void appendPoint(std::string& out, int idx) {
+    out += (char)('a' + Board::colOf(idx));
+    out += (char)('a' + Board::rowOf(idx));
+}
+
+} // namespace
+
+// 把游戏从记录起点到当前局面的全部着法写成一个 SGF 对局
+std::string SgfWriter::write(const AbstractGame& game) {
+    const auto& history = game.getHistory();
+    int size = game.getSize();
+
+    std::string out;
+    out.reserve(64 + history.size() * 6);
+    out += "(;FF[4]GM[";
+    out += (game.getType() == GameType::GO) ? "1" : "4";
+    out += "]SZ[" + std::to_string(size) + "]";
+
+    // 读档后开始记录的对局：用摆子属性写出起始局面
+    Board initial = game.getInitialBoard();
+    for (uint8_t color : {Board::BLACK, Board::WHITE}) {
+        bool any = false;
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                int idx = Board::index(i, j);
+                if (initial.at(idx) != color) continue;
+                if (!any) out += (color == Board::BLACK) ? "AB" : "AW";
+                any = true;
+                out += '[';
+                appendPoint(out, idx);
+                out += ']';
+            }
+        }
+    }
+    PieceColor first = history.empty() ? game.getCurrentPlayer() : history.front().player;
+    if (first == PieceColor::WHITE) out += "PL[W]";
+
+    for (size_t k = 0; k < history.size(); ++k) {
+        if (k % 10 == 0) out += '\n';
+        const auto& rec = history[k];
+        out += (rec.player == PieceColor::BLACK) ? ";B[" : ";W[";
+        if (rec.idx >= 0) appendPoint(out, rec.idx);
+        out += ']';
+    }
+    out += ")\n";
+    return out;
+}
+
+// 把一局追加到棋谱集合文件末尾
+void SgfWriter::append(const std::string& path, const AbstractGame& game) {
+    std::ofstream ofs(path, std::ios::binary | std::ios::app);
+    if (!ofs) throw GameException("文件创建失败");
+    ofs << write(game);
+}
@@ -0,0 +1,53 @@
+#ifndef SGF_H
+#define SGF_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <cstddef>
+#include "AbstractGame.h"
+#include "MappedFile.h"
+
+// SGF 棋谱读取器：顺序扫描整个对局集合，一次只处理一局
+// 属性值以 string_view 直接引用输入缓冲区，不做拷贝；着法边解析边通过 AbstractGame::makeMove 落子
+// 只跟随主线（每个分支的第一个变化），其余变化直接跳过
+class SgfReader {
+private:
+    std::unique_ptr<MappedFile> file; // 从文件读取时持有映射
+    const char* data;
+    size_t length;
+    size_t pos = 0;
+    int depth = 0; // 当前所在的括号层数，出错时据此跳到本局末尾
+    int gamesRead = 0;
+
+    void skipSpace();
+    std::string_view readIdent();
+    std::string_view readValue();
+    void skipToGameEnd();
+    bool seekGameStart();
+
+public:
+    SgfReader(const char* buf, size_t len) : data(buf), length(len) {}
+    explicit SgfReader(const std::string& path);
+
+    // 读取下一局并在新建的游戏上重放全部着法；没有更多对局时返回 nullptr
+    // 棋谱非法时抛出 GameException，读取位置停在该局之后，可继续读取下一局
+    std::shared_ptr<AbstractGame> nextGame();
+
+    // 跳过下一局（不落子），没有更多对局时返回 false
+    bool skipGame();
+
+    int getGamesRead() const { return gamesRead; }
+};
+
+// SGF 棋谱写出器
+class SgfWriter {
+public:
+    // 把游戏从记录起点到当前局面的全部着法写成一个 SGF 对局
+    static std::string write(const AbstractGame& game);
+
+    // 把一局追加到棋谱集合文件末尾
+    static void append(const std::string& path, const AbstractGame& game);
+};
+
+#endif // SGF_H
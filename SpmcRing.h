@@ -0,0 +1,75 @@
+#ifndef SPMCRING_H
+#define SPMCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// 有界无锁环形队列：单生产者、多消费者
+// 每个槽带一个序号，生产者和消费者只靠序号判断槽是否可写/可读，不加锁
+// 槽对象预先构造并反复复用，生产者在槽内原地填写，消费者在槽内原地读取，
+// 槽里的 string/vector 保留容量，稳定运行后入队出队都不分配内存
+template <typename T>
+class SpmcRing {
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        T value;
+    };
+
+    size_t mask;
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<uint64_t> head{0}; // 下一个要读的位置（消费者竞争）
+    alignas(64) uint64_t tail = 0;             // 下一个要写的位置（只有生产者访问）
+
+public:
+    // 容量向上取整为 2 的幂
+    explicit SpmcRing(size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        mask = cap - 1;
+        slots.reset(new Slot[cap]);
+        for (size_t i = 0; i < cap; ++i) slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    // 生产者：取得下一个可写的槽，队列满时返回 nullptr；写完后必须调用 publish
+    T* tryClaim() {
+        Slot& s = slots[tail & mask];
+        if (s.seq.load(std::memory_order_acquire) != tail) return nullptr;
+        return &s.value;
+    }
+    void publish() {
+        slots[tail & mask].seq.store(tail + 1, std::memory_order_release);
+        ++tail;
+    }
+
+    // 消费者：抢到一个可读的槽，队列空时返回 nullptr；读完后用同一个 pos 调用 release
+    T* tryAcquire(uint64_t& pos) {
+        pos = head.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& s = slots[pos & mask];
+            int64_t dif = (int64_t)s.seq.load(std::memory_order_acquire) - (int64_t)(pos + 1);
+            if (dif == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return &s.value;
+            } else if (dif < 0) {
+                return nullptr; // 还没写入
+            } else {
+                pos = head.load(std::memory_order_relaxed); // 被其他消费者抢先
+            }
+        }
+    }
+    void release(uint64_t pos) {
+        slots[pos & mask].seq.store(pos + mask + 1, std::memory_order_release);
+    }
+
+    // 近似判断（并发下只作提示）
+    bool empty() const {
+        uint64_t pos = head.load(std::memory_order_acquire);
+        return slots[pos & mask].seq.load(std::memory_order_acquire) != pos + 1;
+    }
+};
+
+#endif // SPMCRING_H
@@ -1,22 +1,24 @@
 #ifndef STRATEGY_H
 #define STRATEGY_H
 
-#include <vector>
 #include <string>
 #include "GameTypes.h"
+#include "Board.h"
 
-// ԽӿڣжӺϷ
+// 策略接口：判断落子合法性
 class IMoveStrategy {
 public:
-    virtual bool isValid(int x, int y, const std::vector<std::vector<int>>& board, int size) = 0;
+    virtual bool isValid(int x, int y, const Board& board) = 0;
     virtual ~IMoveStrategy() = default;
 };
 
-// Խӿڣжʤ
+// 策略接口：判断胜负
 class IWinStrategy {
 public:
-    virtual PieceColor checkWin(const std::vector<std::vector<int>>& board, int size, bool forceEnd = false) = 0;
-    // ȡʤĬΪգԲʵ֣
+    virtual PieceColor checkWin(const Board& board, bool forceEnd = false) = 0;
+    // 落子后的增量判定：只考虑经过 (x, y) 的线（默认退化为全盘检查）
+    virtual PieceColor checkWinAt(const Board& board, int x, int y) { return checkWin(board, false); }
+    // 获取胜负详情描述（默认为空，五子棋可以不实现）
     virtual std::string getResultDescription() { return ""; }
     virtual ~IWinStrategy() = default;
 };
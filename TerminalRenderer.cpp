@@ -0,0 +1,147 @@
+#include "TerminalRenderer.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 终端可见行数，取不到（输出被重定向等）时返回 0
+int terminalRows() {
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+        return info.srWindow.Bottom - info.srWindow.Top + 1;
+    }
+    return 0;
+#else
+    struct winsize ws;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0) return ws.ws_row;
+    return 0;
+#endif
+}
+
+} // namespace
+
+TerminalRenderer::TerminalRenderer() {
+    out.reserve(4096);
+#ifdef _WIN32
+    // 打开控制台的 ANSI 转义序列支持
+    HANDLE h = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetConsoleMode(h, &mode)) SetConsoleMode(h, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+}
+
+TextFrame& TerminalRenderer::beginFrame() {
+    TextFrame& f = frames[current];
+    f.clear();
+    return f;
+}
+
+void TerminalRenderer::moveTo(int row, int col) {
+    char buf[24];
+    int n = std::snprintf(buf, sizeof(buf), "\x1b[%d;%dH", row + 1, col + 1);
+    out.append(buf, n);
+}
+
+void TerminalRenderer::writeRow(const TextFrame& f, int r) {
+    const TextFrame::Row& row = f.row(r);
+    out.append(f.data() + row.start, row.end - row.start);
+}
+
+bool TerminalRenderer::sameRow(const TextFrame& a, int ra, const TextFrame& b, int rb) const {
+    const TextFrame::Row& x = a.row(ra);
+    const TextFrame::Row& y = b.row(rb);
+    int len = x.end - x.start;
+    return len == y.end - y.start && std::memcmp(a.data() + x.start, b.data() + y.start, len) == 0;
+}
+
+void TerminalRenderer::present(const std::string& prompt) {
+    const TextFrame& cur = frames[current];
+    const TextFrame& prev = frames[current ^ 1];
+    out.clear();
+
+    // 帧比终端还高时，回显输入会让屏幕滚动，坐标对不上，只能整屏重绘
+    int height = sink ? 0 : terminalRows();
+    bool full = !hasPrevious || (height > 0 && cur.rowCount() + 2 > height);
+
+    if (full) {
+        out += "\x1b[H\x1b[2J";
+        for (int r = 0; r < cur.rowCount(); ++r) {
+            writeRow(cur, r);
+            out += '\n';
+        }
+        out += prompt;
+    } else {
+        for (int r = 0; r < cur.rowCount(); ++r) {
+            if (r < prev.rowCount() && sameRow(cur, r, prev, r)) continue;
+
+            const TextFrame::Row& a = cur.row(r);
+            bool cellDiff = r < prev.rowCount() && a.cells > 0 && a.cells == prev.row(r).cells;
+            for (int i = 0; cellDiff && i < a.cells; ++i) {
+                if (cur.cellAt(a.firstCell + i).width != prev.cellAt(prev.row(r).firstCell + i).width) cellDiff = false;
+            }
+
+            if (cellDiff) {
+                // 格子布局相同：只重写内容变化的格子（新落的子、被提的子）
+                int col = 0, cursorCol = -1;
+                for (int i = 0; i < a.cells; ++i) {
+                    const TextFrame::Cell& c = cur.cellAt(a.firstCell + i);
+                    const TextFrame::Cell& p = prev.cellAt(prev.row(r).firstCell + i);
+                    if (c.len != p.len || std::memcmp(cur.data() + c.start, prev.data() + p.start, c.len) != 0) {
+                        if (cursorCol != col) moveTo(r, col);
+                        out.append(cur.data() + c.start, c.len);
+                        cursorCol = col + c.width;
+                    }
+                    col += c.width;
+                }
+            } else {
+                moveTo(r, 0);
+                writeRow(cur, r);
+                out += "\x1b[K";
+            }
+        }
+        // 提示行之后（含上一帧多出的行和回显的输入）全部清掉
+        moveTo(cur.rowCount(), 0);
+        out += prompt;
+        out += "\x1b[J";
+    }
+
+    flush();
+    current ^= 1;
+    hasPrevious = true;
+}
+
+// 整帧一次写出
+void TerminalRenderer::flush() {
+    if (sink) {
+        sink->append(out);
+        return;
+    }
+    std::cout.flush();
+#ifdef _WIN32
+    std::fwrite(out.data(), 1, out.size(), stdout);
+    std::fflush(stdout);
+#else
+    const char* p = out.data();
+    size_t left = out.size();
+    while (left > 0) {
+        ssize_t n = ::write(STDOUT_FILENO, p, left);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        p += n;
+        left -= (size_t)n;
+    }
+#endif
+}
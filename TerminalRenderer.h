@@ -0,0 +1,101 @@
+#ifndef TERMINALRENDERER_H
+#define TERMINALRENDERER_H
+
+#include <string>
+#include <vector>
+
+// 一帧画面：所有字节放在同一块缓冲区里，clear 只重置长度不释放内存
+// 行分两种：整行文本行，以及由定宽格子组成的格子行（棋盘）。格子行可以逐格比较
+class TextFrame {
+public:
+    struct Cell {
+        int start; // 在 bytes 中的起始位置
+        int len;
+        int width; // 终端显示宽度（列数）
+    };
+    struct Row {
+        int start, end;       // 整行在 bytes 中的范围
+        int firstCell, cells; // 格子行在 cellList 中的范围，文本行 cells 为 0
+    };
+
+private:
+    std::string bytes;
+    std::vector<Cell> cellList;
+    std::vector<Row> rows;
+
+public:
+    TextFrame() {
+        bytes.reserve(4096);
+        cellList.reserve(20 * 20);
+        rows.reserve(64);
+    }
+
+    void clear() {
+        bytes.clear();
+        cellList.clear();
+        rows.clear();
+    }
+
+    // 追加文本，按 '\n' 拆成多行
+    void text(const std::string& s) {
+        size_t pos = 0;
+        while (true) {
+            size_t nl = s.find('\n', pos);
+            size_t end = (nl == std::string::npos) ? s.size() : nl;
+            int start = (int)bytes.size();
+            bytes.append(s, pos, end - pos);
+            rows.push_back({start, (int)bytes.size(), (int)cellList.size(), 0});
+            if (nl == std::string::npos) break;
+            pos = nl + 1;
+        }
+    }
+
+    // 格子行：beginRow，若干 cell，endRow
+    void beginRow() {
+        rows.push_back({(int)bytes.size(), 0, (int)cellList.size(), 0});
+    }
+    void cell(const char* s, int len, int width) {
+        cellList.push_back({(int)bytes.size(), len, width});
+        bytes.append(s, len);
+        rows.back().cells++;
+    }
+    void cell(const std::string& s, int width) { cell(s.data(), (int)s.size(), width); }
+    void endRow() {
+        rows.back().end = (int)bytes.size();
+    }
+
+    int rowCount() const { return (int)rows.size(); }
+    const Row& row(int i) const { return rows[i]; }
+    const Cell& cellAt(int i) const { return cellList[i]; }
+    const char* data() const { return bytes.data(); }
+};
+
+// 差分渲染器：与上一帧逐行（棋盘逐格）比较，只输出变化的部分和 ANSI 光标移动，
+// 整帧拼好后一次 write 输出。首次绘制、帧高度超出终端高度时退回整屏重绘
+class TerminalRenderer {
+private:
+    TextFrame frames[2];
+    int current = 0;
+    bool hasPrevious = false;
+    std::string out; // 输出缓冲，复用容量
+    std::string* sink = nullptr; // 非空时输出追加到这里（如网络连接的发送缓冲），不写标准输出
+
+    void moveTo(int row, int col); // 0 起始的行列
+    void writeRow(const TextFrame& f, int r);
+    bool sameRow(const TextFrame& a, int ra, const TextFrame& b, int rb) const;
+    void flush();
+
+public:
+    TerminalRenderer();
+
+    // 供组件绘制的当前帧
+    TextFrame& beginFrame();
+    // 与上一帧比较并输出；prompt 放在最后一行，光标停在其后
+    void present(const std::string& prompt);
+    // 下次绘制时整屏重绘（例如终端内容被其他输出打乱）
+    void invalidate() { hasPrevious = false; }
+    // 改为把输出追加到给定缓冲区，此时无法得知终端高度，始终按差分输出
+    void setOutput(std::string* buffer) { sink = buffer; }
+};
+
+#endif // TERMINALRENDERER_H
@@ -1,26 +1,27 @@
 #ifndef UICOMPONENT_H
 #define UICOMPONENT_H
 
-#include <iostream>
 #include <vector>
 #include <memory>
 #include <string>
-#include <iomanip>
+#include <cstdio>
 #include "GameTypes.h"
 #include "Piece.h"
+#include "Board.h"
+#include "TerminalRenderer.h"
 
-//  (Component)
+// 抽象组件 (Component)
 class UIComponent {
 public:
-    virtual void draw() = 0;
+    virtual void draw(TextFrame& frame) = 0;
     virtual void add(std::shared_ptr<UIComponent> c) {
-        // Ĭʵ֣Ҷӽڵ㲻֧
-        throw GameException("Ҷӽڵ㲻֧");
+        // 默认实现：叶子节点不支持添加
+        throw GameException("叶子节点不支持添加子组件");
     }
     virtual ~UIComponent() = default;
 };
 
-// Ͻڵ (Composite) - 
+// 组合节点 (Composite) - 容器
 class PanelComponent : public UIComponent {
 private:
     std::vector<std::shared_ptr<UIComponent>> children;
@@ -33,15 +34,15 @@ public:
         children.push_back(c);
     }
 
-    void draw() override {
-        // λ
+    void draw(TextFrame& frame) override {
+        // 依次绘制所有子组件
         for (const auto& child : children) {
-            child->draw();
+            child->draw(frame);
         }
     }
 };
 
-// Ҷӽڵ - ı (Leaf)
+// 叶子节点 - 文本组件 (Leaf)
 class TextComponent : public UIComponent {
 private:
     std::string text;
@@ -52,41 +53,53 @@ public:
     void setText(const std::string& t) { text = t; }
     void setVisible(bool v) { visible = v; }
 
-    void draw() override {
+    void draw(TextFrame& frame) override {
         if (visible && !text.empty()) {
-            std::cout << text << "\n";
+            frame.text(text);
         }
     }
 };
 
-// Ҷӽڵ -  (Leaf)
+// 叶子节点 - 棋盘组件 (Leaf)
 class BoardComponent : public UIComponent {
-    const std::vector<std::vector<int>>* data = nullptr;
-    int size = 0;
+    Board data; // 保存一份快照（连续内存，拷贝开销很小），游戏对象销毁后仍可安全绘制
 public:
-    void update(const std::vector<std::vector<int>>& d, int s) { data = &d; size = s; }
+    void update(const Board& d) { data = d; }
+    void updateCell(int x, int y, uint8_t v) { data.set(x, y, v); }
     
-    void draw() override {
-        if (!data) return;
-        std::cout << "\n"; // 
-        
-        // к
-        std::cout << "   ";
-        for (int i = 0; i < size; ++i) std::cout << std::setw(2) << i + 1 << " ";
-        std::cout << "\n";
+    // 每个交叉点占一个 3 列宽的格子，渲染器据此只重画变化的点
+    void draw(TextFrame& frame) override {
+        int size = data.getSize();
+        if (size == 0) return;
+        frame.text(""); // 上留白
 
-        // кź
+        char label[8];
+        // 绘制列号
+        frame.beginRow();
+        frame.cell("   ", 3, 3);
         for (int i = 0; i < size; ++i) {
-            std::cout << std::setw(2) << i + 1 << " ";
+            int n = std::snprintf(label, sizeof(label), "%2d ", i + 1);
+            frame.cell(label, n, 3);
+        }
+        frame.endRow();
+
+        // 绘制行号和棋盘
+        const std::string empty = "十 ";
+        const std::string black = PieceFactory::getPiece(PieceColor::BLACK)->getSymbol() + " ";
+        const std::string white = PieceFactory::getPiece(PieceColor::WHITE)->getSymbol() + " ";
+        for (int i = 0; i < size; ++i) {
+            frame.beginRow();
+            int n = std::snprintf(label, sizeof(label), "%2d ", i + 1);
+            frame.cell(label, n, 3);
             for (int j = 0; j < size; ++j) {
-                int val = (*data)[i][j];
-                if (val == 0) std::cout << "ʮ ";
-                else if (val == 1) std::cout << PieceFactory::getPiece(PieceColor::BLACK)->getSymbol() << " ";
-                else if (val == 2) std::cout << PieceFactory::getPiece(PieceColor::WHITE)->getSymbol() << " ";
+                int val = data.get(i, j);
+                if (val == 0) frame.cell(empty, 3);
+                else if (val == 1) frame.cell(black, 3);
+                else if (val == 2) frame.cell(white, 3);
             }
-            std::cout << "\n";
+            frame.endRow();
         }
-        std::cout << "\n"; // 
+        frame.text(""); // 下留白
     }
 };
 
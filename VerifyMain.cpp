@@ -0,0 +1,60 @@
+/*
+ * 对局记录校验入口：并行重放记录文件中的每一局，检查着法合法性与记录的结果
+ * 用法: replay_verifier [--threads N] [--chunk N] [--max-failures N] 记录文件...
+ * 记录格式见 ReplayVerifier.h；全部通过时返回 0，有未通过的记录时返回 1
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "ReplayVerifier.h"
+
+int main(int argc, char* argv[]) {
+    VerifyConfig config;
+    size_t maxFailures = 100;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "缺少参数值: " << arg << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--threads") {
+            config.threads = std::atoi(value().c_str());
+        } else if (arg == "--chunk") {
+            config.chunkSize = (size_t)std::atol(value().c_str());
+        } else if (arg == "--max-failures") {
+            maxFailures = (size_t)std::atol(value().c_str());
+        } else if (arg.size() > 2 && arg.compare(0, 2, "--") == 0) {
+            std::cerr << "未知参数: " << arg << "\n";
+            return 2;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        std::cerr << "用法: replay_verifier [--threads N] [--chunk N] [--max-failures N] 记录文件...\n";
+        return 2;
+    }
+
+    try {
+        VerifySummary summary = ReplayVerifier(config).run(inputs);
+        std::cout << summary.toString() << "\n";
+        for (size_t i = 0; i < summary.failures.size() && i < maxFailures; ++i) {
+            const VerifyFailure& f = summary.failures[i];
+            std::cout << f.file << ":" << f.line << ": " << f.reason << "\n";
+        }
+        if (summary.failures.size() > maxFailures) {
+            std::cout << "... 另有 " << summary.failures.size() - maxFailures << " 条未列出\n";
+        }
+        return summary.failures.empty() ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "错误: " << e.what() << "\n";
+        return 2;
+    }
+}
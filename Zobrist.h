@@ -0,0 +1,61 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+#include "Board.h"
+
+// Zobrist 哈希：每个（位置, 颜色）对应一个 64 位随机键，局面哈希为所有棋子键的异或
+// 落子、提子、换手都只需一次异或即可增量更新
+class Zobrist {
+private:
+    struct Table {
+        uint64_t keys[2][Board::CAPACITY];
+        uint64_t sideKey;
+
+        Table() {
+            // 固定种子的 splitmix64，保证不同进程间哈希一致，可用作持久化的局面键
+            uint64_t seed = 0x9E3779B97F4A7C15ULL;
+            auto next = [&seed]() {
+                uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31);
+            };
+            for (int c = 0; c < 2; ++c) {
+                for (int i = 0; i < Board::CAPACITY; ++i) keys[c][i] = next();
+            }
+            sideKey = next();
+        }
+    };
+
+    static const Table& table() {
+        static const Table t;
+        return t;
+    }
+
+public:
+    // 某位置上某颜色棋子的键，空点与边框为 0
+    static uint64_t piece(int idx, uint8_t v) {
+        if (v == Board::BLACK) return table().keys[0][idx];
+        if (v == Board::WHITE) return table().keys[1][idx];
+        return 0;
+    }
+
+    // 轮到白方时异或进哈希的键
+    static uint64_t side() { return table().sideKey; }
+
+    // 从零计算整盘棋子的哈希（不含行棋方）
+    static uint64_t hashBoard(const Board& board) {
+        uint64_t h = 0;
+        int size = board.getSize();
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                int idx = Board::index(i, j);
+                h ^= piece(idx, board.at(idx));
+            }
+        }
+        return h;
+    }
+};
+
+#endif // ZOBRIST_H
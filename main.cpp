@@ -1,12 +1,12 @@
 /*
- * ԭ main.cpp918УѲΪģ黯ļ
+ * 原 main.cpp（918行）已拆分为多个模块化文件
  */
 
 #include <iostream>
 #include "GameSystem.h"
 
 int main() {
-    // ñػ֧ʾ
+    // 设置本地化以支持中文显示
     std::ios::sync_with_stdio(false);
     
     GameSystem::getInstance()->run();
@@ -0,0 +1,78 @@
+// 对局内核一致性测试：同一串随机着法分别交给 GameKernel 与 AbstractGame::play，
+// 每一手的合法性、棋盘、累计提子、行棋方与胜负须完全相同
+// 围棋内核只禁单劫、GoGame 禁全局同形，GoGame 以劫为由拒绝的着法两边都跳过，只比较不含劫争的序列
+
+#include "GameKernel.h"
+#include "GoGame.h"
+#include "GomokuGame.h"
+#include "TestCheck.h"
+#include <memory>
+#include <random>
+
+namespace {
+
+int countStones(const Board& board, uint8_t color) {
+    int n = 0;
+    for (int i = 0; i < board.getSize(); ++i) {
+        for (int j = 0; j < board.getSize(); ++j) {
+            if (board.get(i, j) == color) ++n;
+        }
+    }
+    return n;
+}
+
+// 一盘随机对局：围棋偶尔停手；任一方终局或达到步数上限即结束
+void compareGame(IGameKernel& kernel, AbstractGame& game, std::mt19937& rng) {
+    int size = game.getSize();
+    bool go = game.getType() == GameType::GO;
+    long captured[3] = {0, 0, 0}; // 按提子方累计，两边的提子数都由落子前后对方子数之差得出
+    long kernelCaptured[3] = {0, 0, 0};
+
+    for (int step = 0; step < size * size * 3 && !game.isOver(); ++step) {
+        uint8_t me = Board::fromColor(game.getCurrentPlayer());
+        uint8_t opp = 3 - me;
+        int oppBefore = countStones(game.getBoard(), opp);
+        int kernelOppBefore = countStones(kernel.getBoard(), opp);
+
+        if (go && rng() % 16 == 0) {
+            CHECK(game.playPass().status == MoveStatus::OK);
+            CHECK(kernel.passTurn());
+        } else {
+            int x = (int)(rng() % size), y = (int)(rng() % size);
+            MoveStatus status = game.play(x, y).status;
+            if (status == MoveStatus::KO) continue; // 劫争：规则不同，跳过
+            CHECK(kernel.tryMove(x, y) == status);
+            if (status != MoveStatus::OK) continue;
+        }
+        captured[me] += oppBefore - countStones(game.getBoard(), opp);
+        kernelCaptured[me] += kernelOppBefore - countStones(kernel.getBoard(), opp);
+
+        CHECK(kernel.getBoard() == game.getBoard());
+        CHECK(kernelCaptured[Board::BLACK] == captured[Board::BLACK]);
+        CHECK(kernelCaptured[Board::WHITE] == captured[Board::WHITE]);
+        if (!game.isOver()) CHECK(kernel.getCurrentPlayer() == game.getCurrentPlayer()); // 终局那一手之后 AbstractGame 不再换手
+        CHECK(kernel.isOver() == game.isOver());
+        CHECK(kernel.getWinner() == game.getWinner());
+    }
+}
+
+template <int N, class Rules, class Game>
+void randomGames(std::mt19937& rng, int size, int games) {
+    GameKernel<N, Rules> kernel(size);
+    for (int g = 0; g < games; ++g) {
+        kernel.reset();
+        Game game(size);
+        compareGame(kernel, game, rng);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(20240611);
+    randomGames<15, GomokuRules, GomokuGame>(rng, 15, 200);
+    randomGames<0, GomokuRules, GomokuGame>(rng, 9, 200);
+    randomGames<9, GoRules, GoGame>(rng, 9, 200);
+    randomGames<0, GoRules, GoGame>(rng, 13, 100);
+    return testResult();
+}
@@ -0,0 +1,132 @@
+// 围棋数子测试：连通分量版 GoScorer 须与改写前的二维 BFS 数子结果一致，死子按归属图提走后再数
+
+#include "GoScoring.h"
+#include "GoStrategy.h"
+#include "TestCheck.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+// 参考实现：改写前 GoWinStrategy::countArea 的逐块 BFS（二维 visited、越界判断）
+GoAreaScore referenceArea(const Board& board) {
+    int size = board.getSize();
+    GoAreaScore area;
+    std::vector<std::vector<bool>> visited(size, std::vector<bool>(size, false));
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            if (board.get(i, j) == Board::BLACK) {
+                area.blackStones++;
+            } else if (board.get(i, j) == Board::WHITE) {
+                area.whiteStones++;
+            } else if (!visited[i][j]) {
+                int areaSize = 0;
+                bool touchBlack = false, touchWhite = false;
+                std::vector<std::pair<int, int>> q = {{i, j}};
+                visited[i][j] = true;
+                for (size_t head = 0; head < q.size(); ++head) {
+                    auto [x, y] = q[head];
+                    areaSize++;
+                    const int dirs[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+                    for (auto& d : dirs) {
+                        int nx = x + d[0], ny = y + d[1];
+                        if (!board.inBounds(nx, ny)) continue;
+                        uint8_t v = board.get(nx, ny);
+                        if (v == Board::BLACK) touchBlack = true;
+                        else if (v == Board::WHITE) touchWhite = true;
+                        else if (!visited[nx][ny]) {
+                            visited[nx][ny] = true;
+                            q.push_back({nx, ny});
+                        }
+                    }
+                }
+                if (touchBlack && !touchWhite) area.blackTerritory += areaSize;
+                else if (!touchBlack && touchWhite) area.whiteTerritory += areaSize;
+            }
+        }
+    }
+    return area;
+}
+
+bool sameArea(const GoAreaScore& a, const GoAreaScore& b) {
+    return a.blackStones == b.blackStones && a.whiteStones == b.whiteStones && a.blackTerritory == b.blackTerritory &&
+           a.whiteTerritory == b.whiteTerritory && a.blackDead == b.blackDead && a.whiteDead == b.whiteDead;
+}
+
+Board randomBoard(std::mt19937& rng, int size) {
+    Board board(size);
+    int density = (int)(rng() % 80);
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            if ((int)(rng() % 100) < density) board.set(i, j, (rng() & 1) ? Board::BLACK : Board::WHITE);
+        }
+    }
+    return board;
+}
+
+// 同一个 GoScorer 连续数很多盘，顺带覆盖标记数组按轮次复用
+void randomBoards(std::mt19937& rng) {
+    GoScorer scorer;
+    for (int n = 0; n < 20000; ++n) {
+        int size = 1 + (int)(rng() % Board::MAX_SIZE);
+        Board board = randomBoard(rng, size);
+        GoAreaScore expected = referenceArea(board);
+        CHECK(sameArea(scorer.countArea(board), expected));
+        CHECK(sameArea(GoWinStrategy::countArea(board), expected));
+
+        // 归属图与数子一致：棋子归自己，只接触一方的空地归该方
+        uint8_t own[Board::CAPACITY];
+        scorer.owners(board, own);
+        int black = 0, white = 0;
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                uint8_t v = board.get(i, j), o = own[Board::index(i, j)];
+                if (v != Board::EMPTY) CHECK(o == v);
+                black += (o == Board::BLACK);
+                white += (o == Board::WHITE);
+            }
+        }
+        CHECK(black == expected.blackStones + expected.blackTerritory);
+        CHECK(white == expected.whiteStones + expected.whiteTerritory);
+    }
+}
+
+// 死子：归属明显偏向对方的棋子提走后再数，其余棋子不动
+void deadStones(std::mt19937& rng) {
+    GoScorer scorer;
+    for (int n = 0; n < 2000; ++n) {
+        int size = 5 + (int)(rng() % 15);
+        Board board = randomBoard(rng, size);
+        OwnershipMap map;
+        map.size = size;
+        Board alive = board;
+        int blackDead = 0, whiteDead = 0;
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                int idx = Board::index(i, j);
+                map.own[idx] = (float)((int)(rng() % 201) - 100) / 100.0f;
+                uint8_t v = board.at(idx);
+                if (v == Board::BLACK && map.own[idx] < -0.5f) {
+                    alive.setAt(idx, Board::EMPTY);
+                    blackDead++;
+                } else if (v == Board::WHITE && map.own[idx] > 0.5f) {
+                    alive.setAt(idx, Board::EMPTY);
+                    whiteDead++;
+                }
+            }
+        }
+        GoAreaScore expected = referenceArea(alive);
+        expected.blackDead = blackDead;
+        expected.whiteDead = whiteDead;
+        CHECK(sameArea(scorer.countAreaWithDeadStones(board, map, 0.5), expected));
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(18);
+    randomBoards(rng);
+    deadStones(rng);
+    return testResult();
+}
@@ -0,0 +1,150 @@
+// 五子棋位棋盘内核测试：AVX2 内核须与标量内核逐位一致，两者又须与逐格暴力计算的连五、成五点一致
+// 不支持 AVX2 的机器上只校验标量内核
+
+#include "GomokuBitboard.h"
+#include "GomokuStrategy.h"
+#include "TestCheck.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace {
+
+// 暴力参考：从 (x, y) 沿 (dx, dy) 数同色子（不含自身）
+int runLength(const Board& board, int x, int y, int dx, int dy, uint8_t c) {
+    int n = 0;
+    for (int i = x + dx, j = y + dy; board.inBounds(i, j) && board.get(i, j) == c; i += dx, j += dy) ++n;
+    return n;
+}
+
+const int DX[4] = {0, 1, 1, 1};
+const int DY[4] = {1, 0, 1, -1};
+
+bool referenceHasFive(const Board& board, uint8_t c) {
+    int size = board.getSize();
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            if (board.get(i, j) != c) continue;
+            for (int d = 0; d < 4; ++d) {
+                if (runLength(board, i, j, DX[d], DY[d], c) >= 4) return true;
+            }
+        }
+    }
+    return false;
+}
+
+// 成五点：空点落下 c 后经过该点的某条线连成五个以上
+bool referenceWinningPoint(const Board& board, int x, int y, uint8_t c) {
+    if (board.get(x, y) != Board::EMPTY) return false;
+    for (int d = 0; d < 4; ++d) {
+        if (1 + runLength(board, x, y, DX[d], DY[d], c) + runLength(board, x, y, -DX[d], -DY[d], c) >= 5) return true;
+    }
+    return false;
+}
+
+bool samePlane(const BitPlane& a, const BitPlane& b) { return std::memcmp(a.w, b.w, sizeof(a.w)) == 0; }
+
+// 位图只能在棋盘范围内有位，隔离列与多余的字保持为 0
+bool onlyOnBoard(const BitPlane& p, int size) {
+    for (int bit = 0; bit < BitPlane::WORDS * 64; ++bit) {
+        int x = bit / GomokuBitboard::STRIDE, y = bit % GomokuBitboard::STRIDE;
+        if (p.test(bit) && (x >= size || y >= size)) return false;
+    }
+    return true;
+}
+
+void checkKernel(const GomokuKernel& k, const Board& board) {
+    int size = board.getSize();
+    GomokuBitboard bb;
+    k.load(board, bb);
+    CHECK(bb.size == size);
+    CHECK(onlyOnBoard(bb.black, size) && onlyOnBoard(bb.white, size) && onlyOnBoard(bb.empty, size));
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            int bit = GomokuBitboard::bit(i, j);
+            uint8_t v = board.get(i, j);
+            CHECK(bb.black.test(bit) == (v == Board::BLACK));
+            CHECK(bb.white.test(bit) == (v == Board::WHITE));
+            CHECK(bb.empty.test(bit) == (v == Board::EMPTY));
+        }
+    }
+
+    for (uint8_t c : {Board::BLACK, Board::WHITE}) {
+        const BitPlane& own = bb.plane(Board::toColor(c));
+        CHECK(k.hasFive(own) == referenceHasFive(board, c));
+
+        BitPlane points;
+        int count = k.winningPoints(own, bb.empty, points);
+        int expected = 0;
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                bool ref = referenceWinningPoint(board, i, j, c);
+                expected += ref;
+                CHECK(points.test(GomokuBitboard::bit(i, j)) == ref);
+            }
+        }
+        CHECK(count == expected);
+        CHECK(onlyOnBoard(points, size));
+        CHECK(GomokuWinStrategy::countThreats(board, Board::toColor(c)) == expected);
+    }
+}
+
+// 两个内核对同一盘面的全部输出须逐位相同
+void checkSameOutput(const GomokuKernel& a, const GomokuKernel& b, const Board& board) {
+    GomokuBitboard x, y;
+    a.load(board, x);
+    b.load(board, y);
+    CHECK(samePlane(x.black, y.black) && samePlane(x.white, y.white) && samePlane(x.empty, y.empty));
+    for (const BitPlane* own : {&x.black, &x.white}) {
+        CHECK(a.hasFive(*own) == b.hasFive(*own));
+        BitPlane pa, pb;
+        CHECK(a.winningPoints(*own, x.empty, pa) == b.winningPoints(*own, x.empty, pb));
+        CHECK(samePlane(pa, pb));
+    }
+}
+
+// 随机盘面：密度从稀到密，黑子偏多时更容易出现连五与成五点
+Board randomBoard(std::mt19937& rng, int size) {
+    Board board(size);
+    int density = 5 + (int)(rng() % 60);
+    int blackShare = 30 + (int)(rng() % 50);
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            if ((int)(rng() % 100) >= density) continue;
+            board.set(i, j, (int)(rng() % 100) < blackShare ? Board::BLACK : Board::WHITE);
+        }
+    }
+    return board;
+}
+
+} // namespace
+
+int main() {
+    const GomokuKernel& scalar = GomokuKernel::scalar();
+    const GomokuKernel* avx2 = GomokuKernel::avx2();
+    if (!avx2) std::printf("AVX2 内核不可用，只校验标量内核\n");
+
+    std::mt19937 rng(17);
+    for (int n = 0; n < 3000; ++n) {
+        int size = 1 + (int)(rng() % Board::MAX_SIZE);
+        Board board = randomBoard(rng, size);
+        checkKernel(scalar, board);
+        if (avx2) {
+            checkKernel(*avx2, board);
+            checkSameOutput(scalar, *avx2, board);
+        }
+    }
+
+    // 满盘与空盘
+    for (int size : {5, 15, 19}) {
+        Board empty(size), full(size);
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) full.set(i, j, Board::BLACK);
+        }
+        for (const Board* b : {&empty, &full}) {
+            checkKernel(scalar, *b);
+            if (avx2) checkSameOutput(scalar, *avx2, *b);
+        }
+    }
+    return testResult();
+}
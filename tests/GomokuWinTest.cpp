@@ -0,0 +1,110 @@
+// 五子棋胜负判定回归测试：落子后的增量判定 checkWinAt 须与整盘判定 checkWin 及逐格扫描的参考实现一致
+
+#include "GomokuStrategy.h"
+#include "TestCheck.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+// 参考实现：逐格、逐方向数连续同色子，不依赖哨兵边框与位棋盘
+PieceColor referenceWin(const Board& board) {
+    static const int dx[4] = {0, 1, 1, 1};
+    static const int dy[4] = {1, 0, 1, -1};
+    int size = board.getSize();
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            uint8_t c = board.get(i, j);
+            if (c != Board::BLACK && c != Board::WHITE) continue;
+            for (int d = 0; d < 4; ++d) {
+                int k = 1;
+                while (k < 5 && board.inBounds(i + k * dx[d], j + k * dy[d]) && board.get(i + k * dx[d], j + k * dy[d]) == c) ++k;
+                if (k == 5) return Board::toColor(c);
+            }
+        }
+    }
+    return PieceColor::NONE;
+}
+
+// 随机对局：每落一子都比较三种判定，出现连五或下满即结束
+void randomGames(std::mt19937& rng, int games) {
+    GomokuWinStrategy win;
+    for (int g = 0; g < games; ++g) {
+        int size = 8 + (int)(rng() % 12);
+        Board board(size);
+        std::vector<int> empty;
+        for (int i = 0; i < size * size; ++i) empty.push_back(i);
+
+        uint8_t color = Board::BLACK;
+        while (!empty.empty()) {
+            size_t k = rng() % empty.size();
+            int m = empty[k];
+            empty[k] = empty.back();
+            empty.pop_back();
+
+            int x = m / size, y = m % size;
+            board.set(x, y, color);
+            PieceColor expected = referenceWin(board);
+            CHECK(win.checkWinAt(board, x, y) == expected);
+            CHECK(win.checkWin(board) == expected);
+            if (expected != PieceColor::NONE) break;
+            color = (color == Board::BLACK) ? Board::WHITE : Board::BLACK;
+        }
+    }
+}
+
+// 贴边与长连：连五碰到棋盘边缘、六连也算胜，落子点在线段中间时两侧都要数到
+void edgeCases() {
+    GomokuWinStrategy win;
+    for (int size : {8, 15, 19}) {
+        int n = size - 1;
+        struct Line { int x0, y0, dx, dy; };
+        const Line lines[] = {
+            {0, 0, 0, 1}, {n, n - 4, 0, 1}, {0, n, 1, 0}, {0, 0, 1, 1}, {n - 4, n - 4, 1, 1}, {0, n, 1, -1}, {n - 4, 4, 1, -1},
+        };
+        for (const Line& l : lines) {
+            for (int mid = 0; mid < 5; ++mid) {
+                Board board(size);
+                for (int k = 0; k < 5; ++k) {
+                    if (k != mid) board.set(l.x0 + k * l.dx, l.y0 + k * l.dy, Board::WHITE);
+                }
+                int x = l.x0 + mid * l.dx, y = l.y0 + mid * l.dy;
+                CHECK(win.checkWin(board) == PieceColor::NONE);
+                board.set(x, y, Board::WHITE);
+                CHECK(win.checkWinAt(board, x, y) == PieceColor::WHITE);
+                CHECK(win.checkWin(board) == PieceColor::WHITE);
+            }
+        }
+
+        // 六连：中间落子连通两段
+        Board board(size);
+        for (int j = 0; j < 6; ++j) {
+            if (j != 2) board.set(3, j, Board::BLACK);
+        }
+        board.set(3, 2, Board::BLACK);
+        CHECK(win.checkWinAt(board, 3, 2) == PieceColor::BLACK);
+
+        // 四连被对方截断不算
+        Board cut(size);
+        for (int j = 0; j < 4; ++j) cut.set(4, j, Board::BLACK);
+        cut.set(4, 4, Board::WHITE);
+        cut.set(4, 5, Board::BLACK);
+        CHECK(win.checkWinAt(cut, 4, 5) == PieceColor::NONE);
+        CHECK(win.checkWinAt(cut, 4, 3) == PieceColor::NONE);
+        CHECK(win.checkWin(cut) == PieceColor::NONE);
+    }
+
+    // 空点上没有棋子，不构成连五
+    Board board(15);
+    for (int j = 0; j < 5; ++j) board.set(7, j, Board::BLACK);
+    CHECK(win.checkWinAt(board, 8, 8) == PieceColor::NONE);
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(20240501);
+    randomGames(rng, 2000);
+    edgeCases();
+    return testResult();
+}
@@ -0,0 +1,141 @@
+// play / unplay 往返测试：随机交替落子、停手与撤销，每次 unplay 之后
+//   1. 局面须与对应 play 之前的快照完全相同（棋盘、哈希、局面历史、行棋方、胜负）
+//   2. 须与从空盘重新下一遍剩余着法得到的新对局相同
+//   3. 围棋的棋串与伪气须与按棋盘整体重建的结果相同
+
+#include "GoGame.h"
+#include "GomokuGame.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Snapshot {
+    Board board;
+    uint64_t hash;
+    std::vector<uint64_t> positions; // 排序后的局面历史
+    PieceColor player;
+    bool over;
+    PieceColor winner;
+};
+
+Snapshot snapshot(const AbstractGame& g) {
+    const auto& h = g.getPositionHistory();
+    std::vector<uint64_t> positions(h.begin(), h.end());
+    std::sort(positions.begin(), positions.end());
+    return {g.getBoard(), g.getHash(), std::move(positions), g.getCurrentPlayer(), g.isOver(), g.getWinner()};
+}
+
+bool sameState(const Snapshot& a, const Snapshot& b) {
+    return a.board == b.board && a.hash == b.hash && a.positions == b.positions && a.player == b.player &&
+           a.over == b.over && a.winner == b.winner;
+}
+
+std::unique_ptr<AbstractGame> newGame(GameType type, int size) {
+    if (type == GameType::GO) return std::make_unique<GoGame>(size);
+    return std::make_unique<GomokuGame>(size);
+}
+
+// 着法：Board 下标，停一手为 -1
+std::unique_ptr<AbstractGame> replay(GameType type, int size, const std::vector<int>& moves) {
+    std::unique_ptr<AbstractGame> g = newGame(type, size);
+    for (int m : moves) {
+        AbstractGame::UndoInfo u = (m < 0) ? g->playPass() : g->play(Board::rowOf(m), Board::colOf(m));
+        CHECK(u.status == MoveStatus::OK);
+    }
+    return g;
+}
+
+// 增量维护的棋串须与整体重建一致：同串关系、子数、伪气数、串哈希
+bool sameChains(const GoChains& a, const Board& board) {
+    GoChains ref;
+    ref.rebuild(board);
+    int size = board.getSize();
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            int idx = Board::index(i, j);
+            if (board.at(idx) == Board::EMPTY) {
+                if (a.headOf(idx) != -1) return false;
+                continue;
+            }
+            int h = a.headOf(idx), r = ref.headOf(idx);
+            if (h < 0 || a.sizeOf(h) != ref.sizeOf(r) || a.libertiesOf(h) != ref.libertiesOf(r) || a.hashOf(h) != ref.hashOf(r)) return false;
+            // 同串关系：与本行之前的棋子比较即可覆盖所有点对
+            for (int k = Board::index(0, 0); k < idx; ++k) {
+                if (board.at(k) != Board::BLACK && board.at(k) != Board::WHITE) continue;
+                if ((a.headOf(k) == h) != (ref.headOf(k) == r)) return false;
+            }
+        }
+    }
+    return true;
+}
+
+void roundTrips(std::mt19937& rng, GameType type, int games) {
+    long unplays = 0;
+    for (int g = 0; g < games; ++g) {
+        int size = (type == GameType::GO) ? 5 + g % 9 : 8 + g % 8;
+        std::unique_ptr<AbstractGame> game = newGame(type, size);
+
+        struct Step {
+            AbstractGame::UndoInfo undo;
+            int move;
+            Snapshot before;
+        };
+        std::vector<Step> stack;
+        std::vector<int> moves;
+
+        for (int op = 0; op < size * size * 4; ++op) {
+            bool back = !stack.empty() && (game->isOver() || rng() % 4 == 0);
+            if (back) {
+                game->unplay(stack.back().undo);
+                CHECK(sameState(snapshot(*game), stack.back().before));
+                stack.pop_back();
+                moves.pop_back();
+                unplays++;
+
+                CHECK(sameState(snapshot(*game), snapshot(*replay(type, size, moves))));
+                CHECK(game->getHash() == (Zobrist::hashBoard(game->getBoard()) ^
+                                          (game->getCurrentPlayer() == PieceColor::WHITE ? Zobrist::side() : 0)));
+                if (type == GameType::GO) CHECK(sameChains(static_cast<GoGame&>(*game).getChains(), game->getBoard()));
+                continue;
+            }
+            if (game->isOver()) break;
+
+            Snapshot before = snapshot(*game);
+            bool pass = rng() % 12 == 0;
+            int x = (int)(rng() % size), y = (int)(rng() % size);
+            AbstractGame::UndoInfo u = pass ? game->playPass() : game->play(x, y);
+            if (u.status != MoveStatus::OK) {
+                // 被拒绝的着法不改动局面，unplay 对它什么也不做
+                CHECK(!pass || type == GameType::GOMOKU);
+                CHECK(sameState(snapshot(*game), before));
+                game->unplay(u);
+                CHECK(sameState(snapshot(*game), before));
+                continue;
+            }
+            stack.push_back({u, pass ? -1 : Board::index(x, y), std::move(before)});
+            moves.push_back(stack.back().move);
+            if (type == GameType::GO) CHECK(sameChains(static_cast<GoGame&>(*game).getChains(), game->getBoard()));
+        }
+
+        // 全部撤回后回到空盘
+        while (!stack.empty()) {
+            game->unplay(stack.back().undo);
+            stack.pop_back();
+        }
+        CHECK(sameState(snapshot(*game), snapshot(*newGame(type, size))));
+    }
+    CHECK(unplays > 0);
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(24);
+    roundTrips(rng, GameType::GO, 120);
+    roundTrips(rng, GameType::GOMOKU, 120);
+    return testResult();
+}
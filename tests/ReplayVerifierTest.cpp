@@ -0,0 +1,90 @@
+// 对局记录校验回归测试：合法记录须通过；非法着法、结果不符、终局后续着与越界的存档头须在对应行报错
+
+#include "ReplayVerifier.h"
+#include "TestCheck.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+// 把 text 写入临时文件并校验，返回统计结果
+VerifySummary verify(const std::string& text) {
+    std::string path = (std::filesystem::temp_directory_path() / "replay_verifier_test.txt").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+    }
+    VerifySummary summary = ReplayVerifier(VerifyConfig{2, 1}).run({path});
+    std::remove(path.c_str());
+    return summary;
+}
+
+bool failsAt(const VerifySummary& s, int line, const std::string& reason) {
+    for (const VerifyFailure& f : s.failures) {
+        if (f.line == line) return f.reason.find(reason) != std::string::npos;
+    }
+    return false;
+}
+
+// 合法记录：五子棋连五、围棋双方停手（空盘按贴目白胜）、从备忘录局面续下
+void goodRecords() {
+    VerifySummary s = verify(
+        "# 合法记录\n"
+        "GOMOKU 15 BLACK 1,1 2,1 1,2 2,2 1,3 2,3 1,4 2,4 1,5\n"
+        "GOMOKU 9 NONE 5,5 5,6\n"
+        "GO 9 WHITE pass pass\n"
+        "GO 9 WHITE 3,3 7,7 3,4 pass\n"
+        "GOMOKU 5 0 BLACK\n"
+        "1 1 1 1 0\n"
+        "2 2 2 2 0\n"
+        "0 0 0 0 0\n"
+        "0 0 0 0 0\n"
+        "0 0 0 0 0\n"
+        "BLACK 1,5\n");
+    CHECK(s.games == 5);
+    CHECK(s.failures.empty());
+    for (const VerifyFailure& f : s.failures) std::fprintf(stderr, "  %d: %s\n", f.line, f.reason.c_str());
+}
+
+// 非法记录：每条只错一处，须在各自的首行报出对应原因
+void badRecords() {
+    VerifySummary s = verify(
+        "GOMOKU 15 NONE 1,1 1,1\n"                                        // 1: 落在已有子处
+        "GOMOKU 15 WHITE 1,1 2,1 1,2 2,2 1,3 2,3 1,4 2,4 1,5\n"           // 2: 结果不符
+        "GOMOKU 15 BLACK 1,1 2,1 1,2 2,2 1,3 2,3 1,4 2,4 1,5 9,9\n"       // 3: 连五后续着
+        "GO 9 WHITE pass pass 5,5\n"                                      // 4: 双方停手后续着
+        "GO 9 -3 BLACK\n"                                                 // 5: 停手计数越界
+        "0 0 0 0 0 0 0 0 0\n0 0 0 0 0 0 0 0 0\n0 0 0 0 0 0 0 0 0\n"
+        "0 0 0 0 0 0 0 0 0\n0 0 0 0 0 0 0 0 0\n0 0 0 0 0 0 0 0 0\n"
+        "0 0 0 0 0 0 0 0 0\n0 0 0 0 0 0 0 0 0\n0 0 0 0 0 0 0 0 0\n"
+        "WHITE pass pass pass pass\n"
+        "GOMOKU 5 2 WHITE\n"                                              // 16: 停手计数超过 1
+        "0 0 0 0 0\n0 0 0 0 0\n0 0 0 0 0\n0 0 0 0 0\n0 0 0 0 0\n"
+        "NONE\n"
+        "GO 5 0 NONE\n"                                                   // 23: 当前玩家为 NONE
+        "0 0 0 0 0\n0 0 0 0 0\n0 0 0 0 0\n0 0 0 0 0\n0 0 0 0 0\n"
+        "NONE\n"
+        "CHESS 8 NONE\n"                                                  // 30: 未知棋类
+        "GOMOKU 99 NONE\n");                                              // 31: 尺寸越界
+    CHECK(s.games == 9);
+    CHECK(s.failures.size() == 9);
+    CHECK(failsAt(s, 1, "第 2 手 1,1 不合法"));
+    CHECK(failsAt(s, 2, "结果不符"));
+    CHECK(failsAt(s, 3, "第 10 手 9,9 不合法: 游戏已结束"));
+    CHECK(failsAt(s, 4, "第 3 手 5,5 不合法: 游戏已结束"));
+    CHECK(failsAt(s, 5, "存档头超出范围"));
+    CHECK(failsAt(s, 16, "存档头超出范围"));
+    CHECK(failsAt(s, 23, "存档头超出范围"));
+    CHECK(failsAt(s, 30, "未知的棋类"));
+    CHECK(failsAt(s, 31, "棋盘尺寸"));
+}
+
+} // namespace
+
+int main() {
+    goodRecords();
+    badRecords();
+    return testResult();
+}
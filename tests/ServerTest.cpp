@@ -0,0 +1,236 @@
+// 服务器端到端测试：启动 game_server 监听 Unix 域套接字，多个客户端同时对局，按顺序检查回复
+// 用法: ServerTest <game_server 可执行文件>
+
+#include "TestCheck.h"
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+std::string socketPath;
+
+// 一个客户端连接：回复是带 ANSI 控制序列的差分界面，只按子串顺序匹配其中的消息
+class Client {
+private:
+    int fd = -1;
+    std::string received;
+    size_t cursor = 0; // 已匹配到的位置，后面的 expect 只在它之后查找
+
+    // 等待更多输出，超时或连接关闭时返回 false
+    bool receive(int timeoutMs) {
+        pollfd p = {fd, POLLIN, 0};
+        if (poll(&p, 1, timeoutMs) <= 0) return false;
+        char buf[4096];
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) return false;
+        received.append(buf, (size_t)n);
+        return true;
+    }
+
+public:
+    std::string error; // 第一处不符合预期的地方
+
+    bool connect() {
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+        return fd >= 0 && ::connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0;
+    }
+
+    ~Client() {
+        if (fd >= 0) ::close(fd);
+    }
+
+    void send(const std::string& lines) {
+        std::string data = lines + "\n";
+        if (::send(fd, data.data(), data.size(), MSG_NOSIGNAL) != (ssize_t)data.size() && error.empty()) error = "发送失败: " + lines;
+    }
+
+    void shutdownWrite() { ::shutdown(fd, SHUT_WR); }
+    void close() {
+        ::close(fd);
+        fd = -1;
+    }
+
+    // 在已匹配位置之后等到 needle 出现
+    void expect(const std::string& needle, int timeoutMs = 10000) {
+        if (!error.empty()) return;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (true) {
+            size_t pos = received.find(needle, cursor);
+            if (pos != std::string::npos) {
+                cursor = pos + needle.size();
+                return;
+            }
+            int left = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0 || !receive(left)) {
+                error = "没有等到: " + needle;
+                return;
+            }
+        }
+    }
+
+    // 服务器关闭连接（之前的输出照常收完）
+    void expectClosed(int timeoutMs = 10000) {
+        if (!error.empty()) return;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        pollfd p = {fd, POLLIN, 0};
+        char buf[4096];
+        while (true) {
+            int left = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0 || poll(&p, 1, left) <= 0) {
+                error = "连接没有关闭";
+                return;
+            }
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0) return;
+            received.append(buf, (size_t)n);
+        }
+    }
+};
+
+// 五子棋：落子、停手被拒、重复落子、悔棋、退出
+std::string gomokuGame() {
+    Client c;
+    if (!c.connect()) return "无法连接";
+    c.send("start gomoku 9");
+    c.expect("当前轮到: BLACK");
+    c.send("move 5 5");
+    c.expect("轮到 WHITE 落子");
+    c.send("pass");
+    c.expect("错误: 五子棋不能停一手");
+    c.send("move 5 5");
+    c.expect("错误: 此处不可落子");
+    c.send("undo");
+    c.expect("已悔棋，轮到 BLACK");
+    c.send("undo");
+    c.expect("错误: 没有可以悔棋的记录");
+    c.send("exit");
+    c.expectClosed();
+    return c.error;
+}
+
+// 围棋：双方停手终局，终局后 genmove 被拒
+std::string goGame() {
+    Client c;
+    if (!c.connect()) return "无法连接";
+    c.send("start go 9");
+    c.expect("当前轮到: BLACK");
+    c.send("move 3 3");
+    c.expect("轮到 WHITE 落子");
+    c.send("pass");
+    c.expect("轮到 BLACK 落子");
+    c.send("pass");
+    c.expect("双方停手");
+    c.expect("最终结果: BLACK 胜");
+    c.send("genmove");
+    c.expect("错误: 游戏已结束");
+    c.send("exit");
+    c.expectClosed();
+    return c.error;
+}
+
+// genmove 要求超长时间与全部线程：服务器按上限（200 毫秒、1 线程）搜索，搜索期间的后续指令排队执行
+std::string clampedSearch() {
+    Client c;
+    if (!c.connect()) return "无法连接";
+    c.send("start go 9");
+    c.expect("当前轮到: BLACK");
+    auto start = std::chrono::steady_clock::now();
+    c.send("genmove 100000 0\nundo");
+    c.expect("电脑");
+    c.expect("1 线程");
+    c.expect("已悔棋，轮到 BLACK");
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (c.error.empty() && ms > 8000) return "genmove 没有按上限结束: " + std::to_string((long)ms) + "ms";
+    c.send("exit");
+    c.expectClosed();
+    return c.error;
+}
+
+// 一次送出多条指令后关闭写方向：搜索期间收到的 EOF 不丢弃已收到的指令
+std::string pipelinedHalfClose() {
+    Client c;
+    if (!c.connect()) return "无法连接";
+    c.send("start gomoku 9\ngenmove\nundo\nmove 1 1");
+    c.shutdownWrite();
+    c.expect("电脑落子");
+    c.expect("已悔棋，轮到 BLACK");
+    c.expect("轮到 WHITE 落子");
+    c.expectClosed();
+    return c.error;
+}
+
+// 搜索进行中断开：会话要等搜索结束才销毁，服务器不受影响
+std::string abandonedSearch() {
+    Client c;
+    if (!c.connect()) return "无法连接";
+    c.send("start go 9");
+    c.expect("当前轮到: BLACK");
+    c.send("genmove 100000");
+    c.close();
+    return std::string();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "用法: ServerTest <game_server>\n");
+        return 2;
+    }
+    socketPath = "/tmp/chess_server_test_" + std::to_string(getpid()) + ".sock";
+
+    pid_t server = fork();
+    if (server == 0) {
+        execl(argv[1], argv[1], "--unix", socketPath.c_str(), "--threads", "2", "--search-threads", "1",
+              "--max-search-ms", "200", (char*)nullptr);
+        _exit(127);
+    }
+
+    // 等服务器开始监听
+    bool up = false;
+    for (int i = 0; i < 100 && !up; ++i) {
+        Client probe;
+        up = probe.connect();
+        if (!up) std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    CHECK(up);
+
+    if (up) {
+        std::vector<std::function<std::string()>> scenarios = {gomokuGame, goGame, clampedSearch, pipelinedHalfClose, abandonedSearch};
+        std::vector<std::string> results(scenarios.size() * 3);
+        std::vector<std::thread> clients;
+        for (size_t i = 0; i < results.size(); ++i) {
+            clients.emplace_back([&, i]() { results[i] = scenarios[i % scenarios.size()](); });
+        }
+        for (auto& t : clients) t.join();
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (!results[i].empty()) std::fprintf(stderr, "客户端 %zu: %s\n", i, results[i].c_str());
+            CHECK(results[i].empty());
+        }
+
+        // 所有客户端结束后服务器仍正常服务
+        std::string last = gomokuGame();
+        if (!last.empty()) std::fprintf(stderr, "最后的客户端: %s\n", last.c_str());
+        CHECK(last.empty());
+    }
+
+    kill(server, SIGTERM);
+    int status = 0;
+    waitpid(server, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) std::fprintf(stderr, "服务器退出状态: %d\n", status);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    return testResult();
+}
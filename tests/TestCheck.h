@@ -0,0 +1,31 @@
+#ifndef TESTCHECK_H
+#define TESTCHECK_H
+
+#include <cstdio>
+
+// 测试用的最小断言：失败时打印位置与表达式并计数，不中断，main 以 testResult() 作为退出码
+// 断言多在随机循环里，失败较多时只打印前 20 次
+
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void testFail(const char* file, int line, const char* expr) {
+    if (++testFailures() <= 20) std::fprintf(stderr, "%s:%d: CHECK(%s) 失败\n", file, line, expr);
+}
+
+inline int testResult() {
+    if (testFailures() > 0) {
+        std::fprintf(stderr, "共 %d 处断言失败\n", testFailures());
+        return 1;
+    }
+    return 0;
+}
+
+#define CHECK(cond)                                        \
+    do {                                                   \
+        if (!(cond)) testFail(__FILE__, __LINE__, #cond); \
+    } while (0)
+
+#endif // TESTCHECK_H